@@ -122,6 +122,10 @@ private:
 
 class AStarTestRunner : public TestRunner {
 public:
+    bool writesAcoColumns() const override {
+        return false;
+    }
+
     void runSingleTest(const string& graphFile, const string& testName) override {
         bool fileLoaded = false;
         vector<vector<double>> graph;
@@ -1,57 +1,573 @@
 #include "AntColony.h"
+#include "ThreadPool.h"
+#include "Dijkstra.h"
+#include "BlockCutTree.h"
+#include "PheromoneStore.h"
 
-#include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <chrono>
+#include <random>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ACO_HAVE_SSE2 1
+#endif
 
 using namespace std;
 
+namespace {
+    // Below this many ants per thread the synchronisation cost outweighs
+    // the parallel speed-up.
+    const int MIN_ANTS_PER_THREAD = 8;
+
+    // Alias draws that may land on visited vertices before selectNext
+    // switches to an exact scan of the unvisited ones.
+    const int MAX_ALIAS_REJECTIONS = 8;
+
+    // Relative slack on the branch-and-bound test, so an ant retracing the
+    // incumbent is not cut by rounding in the summed lengths.
+    const double BOUND_TOLERANCE = 1e-9;
+
+    // Largest graph built with bitmask visited sets (two 64-bit words).
+    const int SMALL_GRAPH_MAX_VERTICES = 128;
+
+    // Lockstep batches run 8 or 16 lanes: enough ants for the column loops
+    // to fill SIMD registers, few enough rows to stay in cache together.
+    const int MIN_BATCH_LANES = 8;
+    const int MAX_BATCH_LANES = 16;
+
+    int lowestBit(uint64_t bits) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(bits);
+#endif
+    }
+
+    int bitCount(uint64_t bits) {
+#if defined(_MSC_VER)
+        return static_cast<int>(__popcnt64(bits));
+#else
+        return __builtin_popcountll(bits);
+#endif
+    }
+
+    template <size_t Words>
+    void setMaskBit(array<uint64_t, Words>& mask, int v) {
+        mask[v >> 6] |= uint64_t{1} << (v & 63);
+    }
+
+    // First pass of the linear scan for a lockstep batch: masks column j of
+    // every lane's row by that lane's visited stamps into masked (both
+    // vertex-major) and adds it to the lane's sum. Each lane adds in column
+    // order, so the sums match the per-ant scan bit for bit.
+    template <int Lanes>
+    void maskBatchRows(const double* const* rows, const uint32_t* stamps, const uint32_t* generations,
+                       int n, double* masked, double* sums) {
+#ifdef ACO_HAVE_SSE2
+        static_assert(Lanes % 4 == 0, "SSE2 lanes come in groups of four");
+
+        __m128i current[Lanes / 4];
+        __m128d acc[Lanes / 2];
+        for (int g = 0; g < Lanes / 4; ++g) {
+            current[g] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(generations + 4 * g));
+        }
+        for (int p = 0; p < Lanes / 2; ++p) {
+            acc[p] = _mm_setzero_pd();
+        }
+
+        for (int j = 0; j < n; ++j) {
+            const uint32_t* columnStamps = stamps + j * Lanes;
+            double* columnWeights = masked + j * Lanes;
+
+            for (int g = 0; g < Lanes / 4; ++g) {
+                // Widen the 32-bit visited flags to 64-bit lanes for the doubles.
+                const __m128i visited = _mm_cmpeq_epi32(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(columnStamps + 4 * g)), current[g]);
+                const __m128d mask0 = _mm_castsi128_pd(_mm_unpacklo_epi32(visited, visited));
+                const __m128d mask1 = _mm_castsi128_pd(_mm_unpackhi_epi32(visited, visited));
+
+                const int lane = 4 * g;
+                const __m128d w0 = _mm_andnot_pd(mask0, _mm_set_pd(rows[lane + 1][j], rows[lane][j]));
+                const __m128d w1 = _mm_andnot_pd(mask1, _mm_set_pd(rows[lane + 3][j], rows[lane + 2][j]));
+
+                _mm_storeu_pd(columnWeights + lane, w0);
+                _mm_storeu_pd(columnWeights + lane + 2, w1);
+                acc[2 * g] = _mm_add_pd(acc[2 * g], w0);
+                acc[2 * g + 1] = _mm_add_pd(acc[2 * g + 1], w1);
+            }
+        }
+
+        for (int p = 0; p < Lanes / 2; ++p) {
+            _mm_storeu_pd(sums + 2 * p, acc[p]);
+        }
+#else
+        for (int lane = 0; lane < Lanes; ++lane) {
+            sums[lane] = 0.0;
+        }
+
+        for (int j = 0; j < n; ++j) {
+            const uint32_t* columnStamps = stamps + j * Lanes;
+            double* columnWeights = masked + j * Lanes;
+
+            for (int lane = 0; lane < Lanes; ++lane) {
+                const double weight = columnStamps[lane] == generations[lane] ? 0.0 : rows[lane][j];
+                columnWeights[lane] = weight;
+                sums[lane] += weight;
+            }
+        }
+#endif
+    }
+
+    // MAX-MIN Ant System settings (Stuetzle & Hoos).
+    const double MMAS_P_BEST = 0.05;
+    const int MMAS_GLOBAL_BEST_INTERVAL = 5;
+    const double MMAS_BRANCHING_LAMBDA = 0.05;
+    const double MMAS_CONVERGED_BRANCHING = 2.0;
+
+    // Non-improving iterations the branching factor must stay converged
+    // before trails are reset: half the stagnation limit, but at least
+    // this many, so the iteration right after a restart never restarts.
+    const int MMAS_MIN_CONVERGED_ITERATIONS = 5;
+
+    // Share of the trail on an edge whose weight changes that is reset to
+    // the level of its neighbours.
+    const double EDGE_UPDATE_TRAIL_RESET = 0.5;
+}
+
+const char* strategyName(ACOStrategy strategy) {
+    switch (strategy) {
+        case ACOStrategy::MaxMin: return "mmas";
+        case ACOStrategy::ColonySystem: return "acs";
+        case ACOStrategy::Elitist: break;
+    }
+    return "elitist";
+}
+
+const char* heuristicName(HeuristicMode mode) {
+    return mode == HeuristicMode::GoalDirected ? "goal" : "inverse";
+}
+
+bool parseHeuristic(const string& name, HeuristicMode& mode) {
+    if (name == "inverse") {
+        mode = HeuristicMode::InverseWeight;
+        return true;
+    }
+    if (name == "goal") {
+        mode = HeuristicMode::GoalDirected;
+        return true;
+    }
+    return false;
+}
+
+const char* samplingName(SamplingMethod method) {
+    switch (method) {
+        case SamplingMethod::Linear: return "linear";
+        case SamplingMethod::PrefixSum: return "prefix";
+        case SamplingMethod::Alias: return "alias";
+        case SamplingMethod::Simd: return "simd";
+    }
+    return "linear";
+}
+
+bool parseSampling(const string& name, SamplingMethod& method) {
+    if (name == "linear") {
+        method = SamplingMethod::Linear;
+        return true;
+    }
+    if (name == "prefix") {
+        method = SamplingMethod::PrefixSum;
+        return true;
+    }
+    if (name == "alias") {
+        method = SamplingMethod::Alias;
+        return true;
+    }
+    if (name == "simd") {
+        method = SamplingMethod::Simd;
+        return true;
+    }
+    return false;
+}
+
+uint64_t resolveSeed(uint64_t requested) {
+    if (requested != 0) {
+        return requested;
+    }
+
+    random_device device;
+    return (static_cast<uint64_t>(device()) << 32) | device();
+}
+
+const char* stopReasonName(ACOStopReason reason) {
+    switch (reason) {
+        case ACOStopReason::Stagnation: return "stagnation";
+        case ACOStopReason::TimeBudget: return "time_budget";
+        case ACOStopReason::TargetReached: return "target_reached";
+        case ACOStopReason::Cancelled: return "cancelled";
+        case ACOStopReason::IterationLimit: break;
+    }
+    return "iteration_limit";
+}
+
+bool ACORunControl::shouldStop(bool pathFound, double bestLength, double elapsed, ACOStopReason& reason) const {
+    if (cancel && cancel->cancelled()) {
+        reason = ACOStopReason::Cancelled;
+        return true;
+    }
+
+    if (targetLength > 0.0 && pathFound && bestLength <= targetLength) {
+        reason = ACOStopReason::TargetReached;
+        return true;
+    }
+
+    if (timeBudget > 0.0 && elapsed >= timeBudget) {
+        reason = ACOStopReason::TimeBudget;
+        return true;
+    }
+
+    return false;
+}
+
+bool parseStrategy(const string& name, ACOStrategy& strategy) {
+    if (name == "elitist") {
+        strategy = ACOStrategy::Elitist;
+        return true;
+    }
+    if (name == "mmas") {
+        strategy = ACOStrategy::MaxMin;
+        return true;
+    }
+    if (name == "acs") {
+        strategy = ACOStrategy::ColonySystem;
+        return true;
+    }
+    return false;
+}
+
 Ant::Ant(int n)
-    : visited(n, false), pathLength(0.0) {}
+    : visitStamp(n, 0), generation(0), pathLength(0.0), repaired(false), pruned(false) {
+    path.reserve(n);
+}
+
+void Ant::reset(int start) {
+    generation++;
+    if (generation == 0) {
+        fill(visitStamp.begin(), visitStamp.end(), 0);
+        generation = 1;
+    }
+
+    path.clear();
+    pathLength = 0.0;
+    repaired = false;
+    pruned = false;
+
+    path.push_back(start);
+    visit(start);
+}
 
-AntColony::AntColony(const vector<vector<double>>& g,
-                     const vector<string>& names,
+AntColony::AntColony(GraphPtr g,
                      int s,
-                     int e)
-    : n(static_cast<int>(g.size())),
+                     int e,
+                     const ACOParameters& params)
+    : n(g->size()),
       start(s),
       end(e),
-      graph(g),
-      labels(names),
-      alpha(1.0),
-      beta(3.0),
-      evaporation(0.3),
-      Q(100.0),
-      numAnts(max(10, static_cast<int>(g.size()))),
-      maxIterations(max(100, static_cast<int>(g.size()) * 20)),
-      stagnationLimit(max(20, static_cast<int>(g.size()) / 2)),
-      tauMin(1e-4),
-      tauMax(10.0),
-      gen(random_device{}()),
-      dist(0.0, 1.0)
+      graph(move(g)),
+      alpha(params.alpha),
+      beta(params.beta),
+      evaporation(params.evaporation),
+      Q(params.Q),
+      alphaPower(powerKind(params.alpha)),
+      numAnts(params.numAnts > 0 ? params.numAnts : max(10, n)),
+      maxIterations(params.maxIterations > 0 ? params.maxIterations : max(100, n * 20)),
+      stagnationLimit(params.stagnationLimit > 0 ? params.stagnationLimit : max(20, n / 2)),
+      logLevel(params.logLevel),
+      candidateListSize(max(0, params.candidateListSize)),
+      lazyEvaporation(params.lazyEvaporation),
+      strategy(params.strategy),
+      sampling(params.sampling),
+      repairAnts(params.repairAnts),
+      heuristic(params.heuristic),
+      pruneDeadEnds(params.pruneDeadEnds),
+      branchAndBound(params.branchAndBound),
+      timeBudget(params.timeBudget),
+      targetLength(params.targetLength),
+      acsQ0(params.acsQ0),
+      acsLocalEvaporation(params.acsLocalEvaporation),
+      acsInitialTrail(1.0),
+      tauMin(ELITIST_TAU_MIN),
+      tauMax(ELITIST_TAU_MAX),
+      smallGraphWords(0),
+      batchLanes(0),
+      seed(resolveSeed(params.seed)),
+      iteration(0),
+      numThreads(ThreadPool::resolveThreadCount(params.numThreads, numAnts, MIN_ANTS_PER_THREAD)),
+      globalBestLength(numeric_limits<double>::max()),
+      noImprovement(0),
+      foundAnyPathEver(false),
+      convergedIterations(0)
 {
-    pheromone.assign(n, vector<double>(n, 1.0));
+    workers.resize(numThreads);
+    for (auto& worker : workers) {
+        worker.probabilities.assign(n, 0.0);
+    }
+
+    ants.reserve(numAnts);
+    for (int k = 0; k < numAnts; ++k) {
+        ants.emplace_back(n);
+    }
+
+    pheromone = PheromoneMatrix(n, 1.0);
+    if (lazyEvaporation) {
+        pheromone.setLazyEvaporation(evaporation, tauMin, tauMax);
+    }
+
+    computeDistances();
+
+    int arcCount = 0;
+    heuristicPow.assign(n, vector<double>(n, 0.0));
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            heuristicPow[i][j] = heuristicEntry(i, j);
+            if (heuristicPow[i][j] > 0.0) {
+                arcCount++;
+            }
+        }
+    }
+    averageDegree = n > 0 ? static_cast<double>(arcCount) / n : 0.0;
+
+    if (sampling == SamplingMethod::Alias && (lazyEvaporation || strategy == ACOStrategy::ColonySystem)) {
+        sampling = SamplingMethod::PrefixSum;
+    }
+
+    // ACS starts every trail at tau0 = Q / (n * Lnn) and its local update
+    // pulls traversed edges back towards it.
+    if (strategy == ACOStrategy::ColonySystem) {
+        const double nearestLength = nearestNeighbourLength();
+        if (nearestLength > 0.0) {
+            acsInitialTrail = Q / (n * nearestLength);
+        }
+        fillTrails(acsInitialTrail);
+    }
+
+    if (!lazyEvaporation) {
+        choiceInfo.assign(n, vector<double>(n, 0.0));
+        updateChoiceInfo();
+    }
+
+    if (candidateListSize > 0) {
+        buildCandidateLists();
+    }
+
+    // Mask construction covers the eager linear roulette only: the other
+    // samplers and candidate lists exist for rows far longer than 128.
+    if (n <= SMALL_GRAPH_MAX_VERTICES && !lazyEvaporation && candidateListSize == 0 &&
+        sampling == SamplingMethod::Linear) {
+        smallGraphWords = n <= 64 ? 1 : 2;
+        adjacencyMasks.resize(n);
+        for (int i = 0; i < n; ++i) {
+            buildAdjacencyMask(i);
+        }
+    }
+
+    // Batches replay the linear scan lane by lane; ACS must see every
+    // earlier ant's local update, and small graphs are faster on masks.
+    if (params.antBatch > 1 && smallGraphWords == 0 && !lazyEvaporation && candidateListSize == 0 &&
+        sampling == SamplingMethod::Linear && strategy != ACOStrategy::ColonySystem) {
+        batchLanes = params.antBatch <= MIN_BATCH_LANES ? MIN_BATCH_LANES : MAX_BATCH_LANES;
+        for (auto& worker : workers) {
+            worker.batchStamps.assign(static_cast<size_t>(n) * batchLanes, 0);
+            worker.batchWeights.assign(static_cast<size_t>(n) * batchLanes, 0.0);
+            worker.batchGenerations.assign(batchLanes, 0);
+            worker.idleRow.assign(n, 0.0);
+        }
+    }
 }
 
-int AntColony::selectNext(const Ant& ant, int current) {
-    vector<double> probabilities(n, 0.0);
-    double sum = 0.0;
+// Remaining distance to end added to every edge for the goal-directed
+// heuristic; all zeros reproduces the plain inverse weight. Vertices off
+// every simple start-end path are dead ends for any ant.
+void AntColony::computeDistances() {
+    toEnd.assign(n, 0.0);
+    if (heuristic == HeuristicMode::GoalDirected || repairAnts || branchAndBound) {
+        vector<double> distances = Dijkstra::distancesFrom(graph->matrix(), end, repairAnts ? &towardsEnd : nullptr);
+        if (branchAndBound) {
+            lowerBound = distances;
+        }
+        if (heuristic == HeuristicMode::GoalDirected) {
+            toEnd.swap(distances);
+        }
+    }
+
+    usable.assign(n, true);
+    if (pruneDeadEnds) {
+        const vector<bool> onPath = BlockCutTree(graph->matrix(), start).verticesOnSimplePaths(start, end);
+        if (onPath[start]) {
+            usable = onPath;
+        }
+    }
+}
+
+double AntColony::heuristicEntry(int i, int j) const {
+    if (i == j || graph->weight(i, j) <= 0.0 || !usable[i] || !usable[j] ||
+        toEnd[j] == numeric_limits<double>::infinity()) {
+        return 0.0;
+    }
+    return pow(1.0 / (graph->weight(i, j) + toEnd[j]), beta);
+}
+
+void AntColony::buildCandidateLists() {
+    candidateLists.assign(n, {});
+    candidateListComplete.assign(n, true);
+
+    for (int i = 0; i < n; ++i) {
+        buildCandidateList(i);
+    }
+}
+
+void AntColony::buildCandidateList(int i) {
+    vector<int> neighbours;
+    for (int j = 0; j < n; ++j) {
+        if (heuristicPow[i][j] > 0.0) {
+            neighbours.push_back(j);
+        }
+    }
+
+    candidateListComplete[i] = true;
+    if (static_cast<int>(neighbours.size()) > candidateListSize) {
+        const vector<double>& row = heuristicPow[i];
+        nth_element(neighbours.begin(),
+                    neighbours.begin() + candidateListSize,
+                    neighbours.end(),
+                    [&row](int a, int b) {
+                        return row[a] > row[b] || (row[a] == row[b] && a < b);
+                    });
+        neighbours.resize(candidateListSize);
+        candidateListComplete[i] = false;
+    }
+
+    // Keep the list in column order so that a list covering the whole
+    // neighbourhood samples exactly like the full row scan.
+    sort(neighbours.begin(), neighbours.end());
+    candidateLists[i] = move(neighbours);
+}
+
+AntColony::~AntColony() = default;
+
+// Under lazy evaporation the weight is computed on read with the policy the
+// caller dispatched once for its whole scan.
+template <typename Power>
+double AntColony::choiceWeight(int current, int j, Power power) const {
+    if (!lazyEvaporation) {
+        return choiceInfo[current][j];
+    }
+
+    const double eta = heuristicPow[current][j];
+    if (eta <= 0.0) {
+        return 0.0;
+    }
+
+    return power(pheromone.get(current, j)) * eta;
+}
+
+// ACS exploitation: the unvisited neighbour with the largest choice weight,
+// looking at the candidate list first.
+template <typename Power>
+int AntColony::selectGreedy(const Ant& ant, int current, Power power) const {
+    int best = -1;
+    double bestWeight = 0.0;
+
+    if (candidateListSize > 0) {
+        for (int j : candidateLists[current]) {
+            const double weight = ant.isVisited(j) ? 0.0 : choiceWeight(current, j, power);
+            if (weight > bestWeight) {
+                bestWeight = weight;
+                best = j;
+            }
+        }
+
+        if (best != -1 || candidateListComplete[current]) {
+            return best;
+        }
+    }
 
     for (int j = 0; j < n; ++j) {
-        if (!ant.visited[j] && graph[current][j] > 0.0) {
-            const double tau = max(tauMin, pheromone[current][j]);
-            const double eta = 1.0 / graph[current][j];
+        const double weight = ant.isVisited(j) ? 0.0 : choiceWeight(current, j, power);
+        if (weight > bestWeight) {
+            bestWeight = weight;
+            best = j;
+        }
+    }
+
+    return best;
+}
+
+template <typename Power>
+int AntColony::selectFromCandidates(const Ant& ant, int current, Worker& worker, Power power) {
+    const vector<int>& candidates = candidateLists[current];
+    const int count = static_cast<int>(candidates.size());
+    vector<double>& weights = worker.probabilities;
+    double sum = 0.0;
+
+    for (int c = 0; c < count; ++c) {
+        const int j = candidates[c];
+        if (ant.isVisited(j)) {
+            weights[c] = 0.0;
+        } else {
+            weights[c] = choiceWeight(current, j, power);
+        }
+        sum += weights[c];
+    }
+
+    if (sum <= 0.0) {
+        return -1;
+    }
 
-            probabilities[j] = pow(tau, alpha) * pow(eta, beta);
-            sum += probabilities[j];
+    const double r = worker.rng.uniform() * sum;
+    double cumulative = 0.0;
+    int first = -1;
+
+    for (int c = 0; c < count; ++c) {
+        if (weights[c] > 0.0) {
+            cumulative += weights[c];
+            if (cumulative >= r) {
+                return candidates[c];
+            }
+            if (first == -1) {
+                first = candidates[c];
+            }
         }
     }
 
+    return first;
+}
+
+// Full-row roulette over trails evaporated on read, with tau^alpha inlined
+// for the policy chosen at construction.
+template <typename Power>
+int AntColony::sampleLazyRow(const Ant& ant, int current, Worker& worker, Power power) {
+    vector<double>& probabilities = worker.probabilities;
+
+    double sum = 0.0;
+    for (int j = 0; j < n; ++j) {
+        const double eta = heuristicPow[current][j];
+        probabilities[j] = ant.isVisited(j) || eta <= 0.0 ? 0.0 : power(pheromone.get(current, j)) * eta;
+        sum += probabilities[j];
+    }
+
     if (sum <= 0.0) {
         return -1;
     }
 
-    const double r = dist(gen) * sum;
+    const double r = worker.rng.uniform() * sum;
     double cumulative = 0.0;
 
     for (int j = 0; j < n; ++j) {
@@ -72,165 +588,1044 @@ int AntColony::selectNext(const Ant& ant, int current) {
     return -1;
 }
 
-void AntColony::evaporatePheromones() {
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            pheromone[i][j] *= (1.0 - evaporation);
+int AntColony::selectNext(const Ant& ant, int current, Worker& worker) {
+    if (strategy == ACOStrategy::ColonySystem && worker.rng.uniform() < acsQ0) {
+        return dispatchPower(alphaPower, alpha, [&](auto power) {
+            return selectGreedy(ant, current, power);
+        });
+    }
+
+    if (candidateListSize > 0) {
+        const int next = dispatchPower(alphaPower, alpha, [&](auto power) {
+            return selectFromCandidates(ant, current, worker, power);
+        });
+        if (next != -1 || candidateListComplete[current]) {
+            return next;
         }
     }
-}
 
-void AntColony::clampPheromones() {
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            pheromone[i][j] = min(tauMax, max(tauMin, pheromone[i][j]));
+    vector<double>& probabilities = worker.probabilities;
+
+    if (!lazyEvaporation) {
+        const double* row = choiceInfo[current].data();
+        const uint32_t* stamps = ant.visitStamp.data();
+
+        switch (sampling) {
+            case SamplingMethod::PrefixSum:
+                return RouletteSampler::prefixSearch(row, stamps, ant.generation, n, worker.rng.uniform(), probabilities.data());
+            case SamplingMethod::Simd:
+                return RouletteSampler::simdScan(row, stamps, ant.generation, n, worker.rng.uniform(), probabilities.data());
+            case SamplingMethod::Alias: {
+                const AliasTable& table = aliasTables[current];
+                if (table.empty()) {
+                    return -1;
+                }
+
+                for (int attempt = 0; attempt < MAX_ALIAS_REJECTIONS; ++attempt) {
+                    const int j = table.sample(worker.rng.uniform());
+                    if (!ant.isVisited(j)) {
+                        return j;
+                    }
+                }
+
+                return RouletteSampler::prefixSearch(row, stamps, ant.generation, n, worker.rng.uniform(), probabilities.data());
+            }
+            case SamplingMethod::Linear:
+                return RouletteSampler::linearScan(row, stamps, ant.generation, n, worker.rng.uniform(), probabilities.data());
         }
     }
+
+    return dispatchPower(alphaPower, alpha, [&](auto power) {
+        return sampleLazyRow(ant, current, worker, power);
+    });
 }
 
-void AntColony::depositPath(const vector<int>& path, double pathLength, double multiplier) {
-    if (path.empty() || pathLength <= 0.0 || pathLength == numeric_limits<double>::max()) {
-        return;
+void AntColony::evaporatePheromones() {
+    pheromone.evaporateAndClamp(evaporation, tauMin);
+}
+
+double AntColony::trailPower(double tau) const {
+    return dispatchPower(alphaPower, alpha, [tau](auto power) {
+        return power(tau);
+    });
+}
+
+void AntColony::updateChoiceInfo() {
+    dispatchPower(alphaPower, alpha, [this](auto power) {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                if (heuristicPow[i][j] > 0.0) {
+                    choiceInfo[i][j] = power(pheromone.get(i, j)) * heuristicPow[i][j];
+                }
+            }
+        }
+    });
+
+    if (sampling == SamplingMethod::Alias) {
+        buildAliasTables();
     }
+}
 
-    const double pheromoneAmount = multiplier * (Q / pathLength);
+void AntColony::buildAliasTables() {
+    aliasTables.resize(n);
+    for (int i = 0; i < n; ++i) {
+        aliasTables[i].build(choiceInfo[i].data(), n);
+    }
+}
 
-    for (size_t i = 0; i + 1 < path.size(); ++i) {
-        const int u = path[i];
-        const int v = path[i + 1];
+void AntColony::setTrail(int u, int v, double value) {
+    pheromone.set(u, v, value);
 
-        pheromone[u][v] += pheromoneAmount;
-        pheromone[v][u] += pheromoneAmount;
+    if (!lazyEvaporation) {
+        const double tauPow = trailPower(pheromone.get(u, v));
+        choiceInfo[u][v] = tauPow * heuristicPow[u][v];
+        choiceInfo[v][u] = tauPow * heuristicPow[v][u];
     }
 }
 
-string AntColony::buildPathLabels(const vector<int>& path) const {
-    string result;
+void AntColony::fillTrails(double level) {
+    if (warmProfile.empty()) {
+        pheromone.fill(level);
+        return;
+    }
 
-    for (size_t i = 0; i < path.size(); ++i) {
-        result += labels[path[i]];
-        if (i + 1 < path.size()) {
-            result += " -> ";
+    size_t k = 0;
+    for (int u = 0; u < n; ++u) {
+        for (int v = u + 1; v < n; ++v) {
+            pheromone.set(u, v, level * warmProfile[k++]);
         }
     }
-
-    return result;
 }
 
-ACOResult AntColony::run() {
-    ACOResult result;
+bool AntColony::warmStart(PheromoneStore& store) {
+    vector<double> profile = store.warmStart(PheromoneStore::fingerprint(graph->matrix()));
+    if (profile.size() != static_cast<size_t>(n) * (n > 0 ? n - 1 : 0) / 2) {
+        return false;
+    }
 
-    vector<int> globalBestPath;
-    double globalBestLength = numeric_limits<double>::max();
+    warmProfile = move(profile);
+    fillTrails(strategy == ACOStrategy::ColonySystem ? acsInitialTrail : 1.0);
 
-    int noImprovement = 0;
-    bool foundAnyPathEver = false;
+    if (!lazyEvaporation) {
+        updateChoiceInfo();
+    }
+    return true;
+}
 
-    for (int it = 0; it < maxIterations; ++it) {
-        result.iterations = it + 1;
+void AntColony::saveTrails(PheromoneStore& store) const {
+    store.store(PheromoneStore::fingerprint(graph->matrix()), pheromone);
+}
 
-        vector<Ant> ants;
-        ants.reserve(numAnts);
+void AntColony::depositPath(const vector<int>& path, double pathLength, double multiplier) {
+    if (path.empty() || pathLength <= 0.0 || pathLength == numeric_limits<double>::max()) {
+        return;
+    }
 
-        for (int k = 0; k < numAnts; ++k) {
-            ants.emplace_back(n);
-            ants.back().path.push_back(start);
-            ants.back().visited[start] = true;
-        }
+    const double pheromoneAmount = multiplier * (Q / pathLength);
 
-        vector<int> iterationBestPath;
-        double iterationBestLength = numeric_limits<double>::max();
-        bool foundPathThisIteration = false;
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+        const int u = path[i];
+        const int v = path[i + 1];
 
-        for (auto& ant : ants) {
-            while (!ant.path.empty() && ant.path.back() != end) {
-                const int current = ant.path.back();
-                const int next = selectNext(ant, current);
+        pheromone.add(u, v, pheromoneAmount, tauMax);
+    }
+}
 
-                if (next == -1) {
-                    break;
-                }
+// MaskWords > 0 keeps the ant's visited set in that many 64-bit words on
+// the stack and selects through selectSmall; 0 is the general path.
+template <int MaskWords>
+void AntColony::constructAnt(Ant& ant, int antIndex, Worker& worker) {
+    ant.reset(start);
+    worker.rng = PhiloxStream(seed, static_cast<uint32_t>(iteration), static_cast<uint32_t>(antIndex));
 
-                ant.path.push_back(next);
-                ant.visited[next] = true;
-                ant.pathLength += graph[current][next];
-            }
+    VertexMask<MaskWords> visited{};
+    if constexpr (MaskWords > 0) {
+        setMaskBit(visited, start);
+    }
 
-            if (!ant.path.empty() && ant.path.back() == end) {
-                foundPathThisIteration = true;
-                foundAnyPathEver = true;
+    while (ant.path.back() != end) {
+        const int current = ant.path.back();
+        worker.rng.setStep(static_cast<uint32_t>(ant.path.size() - 1));
 
-                if (ant.pathLength < iterationBestLength) {
-                    iterationBestLength = ant.pathLength;
-                    iterationBestPath = ant.path;
-                }
+        int next;
+        if constexpr (MaskWords > 0) {
+            next = selectSmall<MaskWords>(visited, current, worker);
+        } else {
+            next = selectNext(ant, current, worker);
+        }
 
-                if (ant.pathLength < globalBestLength) {
-                    globalBestLength = ant.pathLength;
-                    globalBestPath = ant.path;
-                    result.pathFound = true;
+        if (next == -1) {
+            if (repairAnts) {
+                // The repair walks the stamps, which the mask path skipped.
+                if constexpr (MaskWords > 0) {
+                    for (int v : ant.path) {
+                        ant.visit(v);
+                    }
                 }
+                repairAnt(ant);
             }
+            break;
         }
 
-        evaporatePheromones();
-
-        for (const auto& ant : ants) {
-            if (!ant.path.empty() && ant.path.back() == end) {
-                depositPath(ant.path, ant.pathLength, 1.0);
-            }
+        ant.path.push_back(next);
+        if constexpr (MaskWords > 0) {
+            setMaskBit(visited, next);
+        } else {
+            ant.visit(next);
         }
+        ant.pathLength += graph->weight(current, next);
 
-        if (foundPathThisIteration) {
-            depositPath(iterationBestPath, iterationBestLength, 2.0);
+        if (strategy == ACOStrategy::ColonySystem) {
+            const double tau = pheromone.get(current, next);
+            setTrail(current, next, (1.0 - acsLocalEvaporation) * tau + acsLocalEvaporation * acsInitialTrail);
         }
 
-        if (result.pathFound) {
-            depositPath(globalBestPath, globalBestLength, 3.0);
+        // globalBestLength only changes between iterations, so every ant
+        // sees the same incumbent whatever thread builds it.
+        if (!lowerBound.empty() && next != end &&
+            ant.pathLength + lowerBound[next] > globalBestLength * (1.0 + BOUND_TOLERANCE)) {
+            ant.pruned = true;
+            break;
         }
+    }
+}
 
-        clampPheromones();
+// selectNext for graphs of at most 64 * MaskWords vertices: only the set
+// bits of the row's adjacency mask minus the visited mask are looked at,
+// with every weight in a stack array. Draws and sums happen in the same
+// order as the linear scan over the full row, so seeded runs choose the
+// same vertices.
+template <int MaskWords>
+int AntColony::selectSmall(const VertexMask<MaskWords>& visited, int current, Worker& worker) {
+    const double* row = choiceInfo[current].data();
+    const VertexMask<2>& adjacent = adjacencyMasks[current];
 
-        bool improved = false;
-        if (result.pathFound && globalBestLength < result.bestLength) {
-            result.bestLength = globalBestLength;
-            result.bestPath = globalBestPath;
-            improved = true;
-        }
+    VertexMask<MaskWords> open;
+    int openCount = 0;
+    for (int w = 0; w < MaskWords; ++w) {
+        open[w] = adjacent[w] & ~visited[w];
+        openCount += bitCount(open[w]);
+    }
 
-        if (improved) {
-            noImprovement = 0;
-        } else {
-            noImprovement++;
-        }
+    const bool greedy = strategy == ACOStrategy::ColonySystem && worker.rng.uniform() < acsQ0;
 
-        if (it % 10 == 0) {
-            cout << "Iteration " << it + 1;
-            if (result.pathFound) {
-                cout << " - Best: " << result.bestLength;
-            } else {
-                cout << " - No path found yet";
-            }
-            cout << endl;
-        }
+    int columns[SMALL_GRAPH_MAX_VERTICES];
+    double weights[SMALL_GRAPH_MAX_VERTICES];
+    int count = 0;
+    double sum = 0.0;
 
-       if (foundAnyPathEver && noImprovement >= stagnationLimit) {
-            cout << "Stopped early after " << it + 1
-                 << " iterations due to stagnation." << endl;
-            break;
+    for (int w = 0; w < MaskWords; ++w) {
+        for (uint64_t bits = open[w]; bits != 0; bits &= bits - 1) {
+            const int j = w * 64 + lowestBit(bits);
+            columns[count] = j;
+            weights[count] = row[j];
+            sum += row[j];
+            count++;
         }
     }
 
-    if (result.pathFound) {
-        result.bestPathLabels = buildPathLabels(result.bestPath);
+    if (greedy) {
+        int best = -1;
+        double bestWeight = 0.0;
+        for (int c = 0; c < count; ++c) {
+            if (weights[c] > bestWeight) {
+                bestWeight = weights[c];
+                best = columns[c];
+            }
+        }
+        return best;
+    }
 
-        cout << "SUCCESS: Path found: " << result.bestPathLabels
-             << " (length: " << result.bestLength
-             << ", iterations: " << result.iterations << ")" << endl;
+    const double u = worker.rng.uniform();
+    if (sum <= 0.0) {
+        return -1;
+    }
+    if (openCount == 1) {
+        return columns[0];
+    }
+
+    const double r = u * sum;
+    double cumulative = 0.0;
+
+    for (int c = 0; c < count; ++c) {
+        if (weights[c] > 0.0) {
+            cumulative += weights[c];
+            if (cumulative >= r) {
+                return columns[c];
+            }
+        }
+    }
+
+    for (int c = count - 1; c >= 0; --c) {
+        if (weights[c] > 0.0) {
+            return columns[c];
+        }
+    }
+
+    return -1;
+}
+
+// Builds ants [first, last) Lanes at a time in lockstep: each round every
+// lane takes one step, and a lane whose ant has finished picks up the next
+// ant of the range. Lane state is kept as separate arrays and the visited
+// stamps vertex-major, so the masking pass runs across the lanes one
+// column at a time and the rows of the batch are streamed together; the
+// cumulative pass stops early and stays per lane. Every ant keeps
+// its own (iteration, ant, step) stream and the sums of the linear scan,
+// so seeded runs choose the same vertices as constructAnt.
+template <int Lanes>
+void AntColony::constructBatch(int first, int last, Worker& worker) {
+    uint32_t* stamps = worker.batchStamps.data();
+    double* masked = worker.batchWeights.data();
+
+    array<int, Lanes> antOf;
+    array<int, Lanes> current;
+    array<double, Lanes> length;
+    array<uint32_t, Lanes> generation;
+    array<const double*, Lanes> rows;
+    array<PhiloxStream, Lanes> rng;
+
+    array<double, Lanes> draw;
+    array<double, Lanes> sum;
+    array<int, Lanes> chosen;
+
+    copy(worker.batchGenerations.begin(), worker.batchGenerations.end(), generation.begin());
+
+    int nextAnt = first;
+    int busy = 0;
+
+    // Starts the next ant of the range on the lane, or leaves it idle on
+    // the zero row.
+    auto launch = [&](int lane) {
+        antOf[lane] = -1;
+        rows[lane] = worker.idleRow.data();
+
+        while (nextAnt < last) {
+            const int k = nextAnt++;
+            ants[k].reset(start);
+            if (start == end) {
+                continue;
+            }
+
+            generation[lane]++;
+            if (generation[lane] == 0) {
+                for (int v = 0; v < n; ++v) {
+                    stamps[v * Lanes + lane] = 0;
+                }
+                generation[lane] = 1;
+            }
+            stamps[start * Lanes + lane] = generation[lane];
+
+            antOf[lane] = k;
+            current[lane] = start;
+            length[lane] = 0.0;
+            rows[lane] = choiceInfo[start].data();
+            rng[lane] = PhiloxStream(seed, static_cast<uint32_t>(iteration), static_cast<uint32_t>(k));
+            busy++;
+            return;
+        }
+    };
+
+    for (int lane = 0; lane < Lanes; ++lane) {
+        launch(lane);
+    }
+
+    while (busy > 0) {
+        for (int lane = 0; lane < Lanes; ++lane) {
+            if (antOf[lane] >= 0) {
+                rng[lane].setStep(static_cast<uint32_t>(ants[antOf[lane]].path.size() - 1));
+                draw[lane] = rng[lane].uniform();
+            }
+        }
+
+        // Idle lanes read the zero row and contribute nothing.
+        maskBatchRows<Lanes>(rows.data(), stamps, generation.data(), n, masked, sum.data());
+
+        for (int lane = 0; lane < Lanes; ++lane) {
+            chosen[lane] = -1;
+            if (antOf[lane] < 0 || sum[lane] <= 0.0) {
+                continue;
+            }
+
+            const double target = draw[lane] * sum[lane];
+            double cumulative = 0.0;
+            for (int j = 0; j < n; ++j) {
+                const double weight = masked[j * Lanes + lane];
+                if (weight > 0.0) {
+                    cumulative += weight;
+                    if (cumulative >= target) {
+                        chosen[lane] = j;
+                        break;
+                    }
+                }
+            }
+
+            // Rounding left the target above the total: the last positive
+            // weight, as in the linear scan.
+            for (int j = n - 1; j >= 0 && chosen[lane] == -1; --j) {
+                if (masked[j * Lanes + lane] > 0.0) {
+                    chosen[lane] = j;
+                }
+            }
+        }
+
+        for (int lane = 0; lane < Lanes; ++lane) {
+            if (antOf[lane] < 0) {
+                continue;
+            }
+
+            Ant& ant = ants[antOf[lane]];
+            const int next = chosen[lane];
+
+            bool finished = false;
+            if (next == -1) {
+                ant.pathLength = length[lane];
+                if (repairAnts) {
+                    // The repair walks the ant's own stamps, which the batch
+                    // kept in its column instead.
+                    for (int v : ant.path) {
+                        ant.visit(v);
+                    }
+                    repairAnt(ant);
+                }
+                finished = true;
+            } else {
+                const int from = current[lane];
+                ant.path.push_back(next);
+                stamps[next * Lanes + lane] = generation[lane];
+                length[lane] += graph->weight(from, next);
+                current[lane] = next;
+                rows[lane] = choiceInfo[next].data();
+
+                if (next == end) {
+                    finished = true;
+                } else if (!lowerBound.empty() &&
+                           length[lane] + lowerBound[next] > globalBestLength * (1.0 + BOUND_TOLERANCE)) {
+                    ant.pruned = true;
+                    finished = true;
+                }
+
+                if (finished) {
+                    ant.pathLength = length[lane];
+                }
+            }
+
+            if (finished) {
+                busy--;
+                launch(lane);
+            }
+        }
+    }
+
+    copy(generation.begin(), generation.end(), worker.batchGenerations.begin());
+}
+
+void AntColony::buildAdjacencyMask(int i) {
+    VertexMask<2>& mask = adjacencyMasks[i];
+    mask.fill(0);
+
+    for (int j = 0; j < n; ++j) {
+        if (heuristicPow[i][j] > 0.0) {
+            setMaskBit(mask, j);
+        }
+    }
+}
+
+// Walks the shortest-path tree from the stuck vertex to end. The tree path
+// runs back through visited vertices; each time it does, the loop since
+// that vertex is erased, so the result is still a simple path.
+void AntColony::repairAnt(Ant& ant) const {
+    int v = towardsEnd[ant.path.back()];
+    if (v == -1) {
+        return;
+    }
+
+    while (true) {
+        if (ant.isVisited(v)) {
+            while (ant.path.back() != v) {
+                ant.unvisit(ant.path.back());
+                ant.path.pop_back();
+            }
+        } else {
+            ant.path.push_back(v);
+            ant.visit(v);
+        }
+
+        if (v == end) {
+            break;
+        }
+        v = towardsEnd[v];
+    }
+
+    ant.pathLength = 0.0;
+    for (size_t i = 0; i + 1 < ant.path.size(); ++i) {
+        ant.pathLength += graph->weight(ant.path[i], ant.path[i + 1]);
+    }
+    ant.repaired = true;
+}
+
+void AntColony::constructAnts() {
+    const int antCount = static_cast<int>(ants.size());
+
+    auto task = [this, antCount](int w) {
+        const int first = static_cast<int>(static_cast<long long>(antCount) * w / numThreads);
+        const int last = static_cast<int>(static_cast<long long>(antCount) * (w + 1) / numThreads);
+
+        switch (batchLanes) {
+            case 8: constructBatch<8>(first, last, workers[w]); return;
+            case 16: constructBatch<16>(first, last, workers[w]); return;
+        }
+
+        for (int k = first; k < last; ++k) {
+            switch (smallGraphWords) {
+                case 1: constructAnt<1>(ants[k], k, workers[w]); break;
+                case 2: constructAnt<2>(ants[k], k, workers[w]); break;
+                default: constructAnt<0>(ants[k], k, workers[w]); break;
+            }
+        }
+    };
+
+    // ACS ants read the trails their predecessors just updated locally, so
+    // they are built one after another.
+    if (pool && strategy != ACOStrategy::ColonySystem) {
+        pool->runOnAll(task);
+    } else {
+        for (int w = 0; w < numThreads; ++w) {
+            task(w);
+        }
+    }
+}
+
+void AntColony::updateElitist(const Ant* iterationBest) {
+    evaporatePheromones();
+
+    for (const auto& ant : ants) {
+        if (ant.path.back() == end) {
+            depositPath(ant.path, ant.pathLength, 1.0);
+        }
+    }
+
+    if (iterationBest) {
+        depositPath(iterationBest->path, iterationBest->pathLength, 2.0);
+    }
+
+    if (!globalBestPath.empty()) {
+        depositPath(globalBestPath, globalBestLength, 3.0);
+    }
+}
+
+void AntColony::updateMaxMinBounds() {
+    tauMax = Q / (evaporation * globalBestLength);
+
+    // Average number of choices per step and the number of decisions an
+    // ant makes on the best path.
+    const double avgChoices = max(2.0, averageDegree / 2.0);
+    const int decisions = max(1, static_cast<int>(globalBestPath.size()) - 1);
+    const double pDec = pow(MMAS_P_BEST, 1.0 / decisions);
+
+    // On short best paths the pBest formula puts tauMin within one
+    // evaporation of tauMax, so a single evaporation after a reset would
+    // floor every other edge and the branching factor would read as
+    // converged again. The cap keeps the two bounds apart.
+    tauMin = min(tauMax * (1.0 - pDec) / ((avgChoices - 1.0) * pDec), tauMax / (2.0 * avgChoices));
+
+    if (lazyEvaporation) {
+        pheromone.setLazyBounds(tauMin, tauMax);
+    }
+}
+
+double AntColony::branchingFactor(const vector<int>& path) const {
+    if (path.size() < 2) {
+        return 0.0;
+    }
+
+    const double threshold = tauMin + MMAS_BRANCHING_LAMBDA * (tauMax - tauMin);
+    int strongEdges = 0;
+
+    for (size_t k = 0; k + 1 < path.size(); ++k) {
+        const int i = path[k];
+        for (int j = 0; j < n; ++j) {
+            if (heuristicPow[i][j] > 0.0 && pheromone.get(i, j) >= threshold) {
+                strongEdges++;
+            }
+        }
+    }
+
+    return static_cast<double>(strongEdges) / (path.size() - 1);
+}
+
+// Usable edges per vertex of the path, the branching factor of trails
+// that are all at tauMax.
+double AntColony::edgesPerStep(const vector<int>& path) const {
+    if (path.size() < 2) {
+        return 0.0;
+    }
+
+    int edges = 0;
+    for (size_t k = 0; k + 1 < path.size(); ++k) {
+        for (int j = 0; j < n; ++j) {
+            if (heuristicPow[path[k]][j] > 0.0) {
+                edges++;
+            }
+        }
+    }
+
+    return static_cast<double>(edges) / (path.size() - 1);
+}
+
+bool AntColony::updateMaxMin(int iteration, const Ant* iterationBest, bool improved, bool firstSolution) {
+    if (improved) {
+        updateMaxMinBounds();
+
+        // MAX-MIN starts from trails at the upper bound once the first
+        // solution fixes that bound.
+        if (firstSolution) {
+            fillTrails(tauMax);
+        }
+    }
+
+    evaporatePheromones();
+
+    if (!iterationBest || (iteration + 1) % MMAS_GLOBAL_BEST_INTERVAL == 0) {
+        depositPath(globalBestPath, globalBestLength, 1.0);
+    } else {
+        depositPath(iterationBest->path, iterationBest->pathLength, 1.0);
+    }
+
+    if (improved || globalBestPath.empty() || branchingFactor(globalBestPath) > MMAS_CONVERGED_BRANCHING) {
+        convergedIterations = 0;
+        return false;
+    }
+
+    // Where the best path has no alternatives, trails at tauMax read as
+    // converged too and a reset cannot change anything.
+    if (edgesPerStep(globalBestPath) <= MMAS_CONVERGED_BRANCHING) {
+        return false;
+    }
+
+    convergedIterations++;
+    if (convergedIterations < max(MMAS_MIN_CONVERGED_ITERATIONS, stagnationLimit / 2)) {
+        return false;
+    }
+
+    pheromone.fill(tauMax);
+    convergedIterations = 0;
+    return true;
+}
+
+double AntColony::nearestNeighbourLength() const {
+    vector<bool> visited(n, false);
+    int current = start;
+    double length = 0.0;
+    visited[current] = true;
+
+    while (current != end) {
+        int next = -1;
+        for (int j = 0; j < n; ++j) {
+            if (!visited[j] && heuristicPow[current][j] > 0.0 &&
+                (next == -1 || graph->weight(current, j) < graph->weight(current, next))) {
+                next = j;
+            }
+        }
+
+        if (next == -1) {
+            return 0.0;
+        }
+
+        length += graph->weight(current, next);
+        visited[next] = true;
+        current = next;
+    }
+
+    return length;
+}
+
+void AntColony::updateColonySystem() {
+    if (globalBestPath.empty()) {
+        return;
+    }
+
+    const double deposit = Q / globalBestLength;
+
+    for (size_t i = 0; i + 1 < globalBestPath.size(); ++i) {
+        const int u = globalBestPath[i];
+        const int v = globalBestPath[i + 1];
+        const double tau = pheromone.get(u, v);
+
+        setTrail(u, v, (1.0 - evaporation) * tau + evaporation * deposit);
+    }
+}
+
+ACOResult AntColony::run() {
+    ACORunControl control;
+    control.timeBudget = timeBudget;
+    control.targetLength = targetLength;
+    return run(control);
+}
+
+void AntColony::begin() {
+    current = ACOResult();
+    current.seed = seed;
+
+    globalBestPath.clear();
+    globalBestPath.reserve(n);
+    globalBestLength = numeric_limits<double>::max();
+
+    noImprovement = 0;
+    foundAnyPathEver = false;
+    convergedIterations = 0;
+
+    if (numThreads > 1 && !pool) {
+        pool = make_unique<ThreadPool>(numThreads);
+    }
+
+    runStart = chrono::steady_clock::now();
+}
+
+bool AntColony::iterate() {
+    const int it = current.iterations;
+    current.iterations = it + 1;
+    iteration = it;
+
+    constructAnts();
+
+    const bool hadSolution = foundAnyPathEver;
+    const Ant* iterationBest = nullptr;
+    bool improved = false;
+    ACOIterationStats stats;
+    stats.ants = static_cast<int>(ants.size());
+
+    // Reduce in ant order so the outcome does not depend on scheduling.
+    for (const auto& ant : ants) {
+        if (ant.path.back() == end) {
+            foundAnyPathEver = true;
+            stats.successful++;
+            if (ant.repaired) {
+                stats.repaired++;
+            }
+
+            if (!iterationBest || ant.pathLength < iterationBest->pathLength) {
+                iterationBest = &ant;
+            }
+
+            if (ant.pathLength < globalBestLength) {
+                globalBestLength = ant.pathLength;
+                globalBestPath = ant.path;
+                improved = true;
+            }
+        } else if (ant.pruned) {
+            stats.pruned++;
+        }
+    }
+
+    stats.bestLength = globalBestLength;
+    current.history.push_back(stats);
+
+    // Not after an edge update dropped the best path: the trails still
+    // hold what the colony learnt before.
+    const bool firstSolution = improved && !hadSolution;
+
+    if (improved) {
+        recordBest();
+    }
+
+    if (strategy == ACOStrategy::MaxMin) {
+        if (updateMaxMin(it, iterationBest, improved, firstSolution)) {
+            current.restarts++;
+        }
+    } else if (strategy == ACOStrategy::ColonySystem) {
+        updateColonySystem();
+    } else {
+        updateElitist(iterationBest);
+    }
+
+    // ACS keeps the choice info current edge by edge.
+    if (!lazyEvaporation && strategy != ACOStrategy::ColonySystem) {
+        updateChoiceInfo();
+    }
+
+    if (improved) {
+        noImprovement = 0;
+    } else {
+        noImprovement++;
+    }
+
+    return improved;
+}
+
+void AntColony::recordBest() {
+    current.pathFound = true;
+    current.bestLength = globalBestLength;
+    current.bestPath = globalBestPath;
+    current.bestIteration = current.iterations;
+    current.timeToBest = elapsedSeconds();
+}
+
+bool AntColony::exhausted() const {
+    return current.iterations >= maxIterations || stagnated();
+}
+
+bool AntColony::stagnated() const {
+    return foundAnyPathEver && noImprovement >= stagnationLimit;
+}
+
+double AntColony::elapsedSeconds() const {
+    return chrono::duration<double>(chrono::steady_clock::now() - runStart).count();
+}
+
+ACOResult AntColony::finish() const {
+    ACOResult result = current;
+
+    if (result.pathFound) {
+        result.bestPathLabels = graph->labels().join(result.bestPath, " -> ");
     } else {
         result.bestLength = numeric_limits<double>::max();
-        cout << "FAIL: No path found from " << labels[start]
-             << " to " << labels[end] << endl;
+    }
+
+    return result;
+}
+
+bool AntColony::immigrate(const vector<int>& path, double length) {
+    if (path.empty() || length >= globalBestLength) {
+        return false;
+    }
+
+    const bool firstSolution = !foundAnyPathEver;
+
+    globalBestPath = path;
+    globalBestLength = length;
+    foundAnyPathEver = true;
+    noImprovement = 0;
+    recordBest();
+
+    // The MAX-MIN bounds follow the best length, as after an own improvement.
+    if (strategy == ACOStrategy::MaxMin) {
+        updateMaxMinBounds();
+        if (firstSolution) {
+            fillTrails(tauMax);
+        }
+        if (!lazyEvaporation) {
+            updateChoiceInfo();
+        }
+    }
+
+    return true;
+}
+
+void AntColony::blendTrails(const PheromoneMatrix& other, double weight) {
+    if (other.size() != n || weight <= 0.0) {
+        return;
+    }
+
+    for (int u = 0; u < n; ++u) {
+        for (int v = u + 1; v < n; ++v) {
+            if (graph->weight(u, v) > 0.0) {
+                pheromone.set(u, v, (1.0 - weight) * pheromone.get(u, v) + weight * other.get(u, v));
+            }
+        }
+    }
+
+    if (!lazyEvaporation) {
+        updateChoiceInfo();
+    }
+}
+
+// Mean trail on the other edges at u and v: the level a neutral edge in
+// that part of the graph has reached, which the initial level of the
+// strategies that let trails grow freely says nothing about.
+double AntColony::localTrailLevel(int u, int v) const {
+    double total = 0.0;
+    int count = 0;
+
+    for (int w : {u, v}) {
+        for (int j = 0; j < n; ++j) {
+            if (heuristicPow[w][j] > 0.0 && j != u && j != v) {
+                total += pheromone.get(w, j);
+                count++;
+            }
+        }
+    }
+
+    return count > 0 ? total / count : pheromone.get(u, v);
+}
+
+bool AntColony::setEdgeWeight(int u, int v, double weight) {
+    if (u < 0 || v < 0 || u >= n || v >= n || u == v) {
+        return false;
+    }
+
+    weight = max(0.0, weight);
+    if (graph->weight(u, v) == weight) {
+        return false;
+    }
+
+    if (!ownGraph) {
+        ownGraph = make_shared<Graph>(*graph);
+        graph = ownGraph;
+    }
+    ownGraph->setWeight(u, v, weight);
+
+    // The distances to end and the dead-end set may change far from the
+    // edge; eta is only recomputed in the columns (and for pruning, rows)
+    // of vertices whose value actually moved.
+    const vector<double> oldToEnd = toEnd;
+    const vector<bool> oldUsable = usable;
+    computeDistances();
+
+    vector<bool> dirtyRow(n, false);
+    dirtyRow[u] = true;
+    dirtyRow[v] = true;
+    int arcDelta = 0;
+
+    auto refresh = [&](int i, int j) {
+        const double eta = heuristicEntry(i, j);
+        if (eta == heuristicPow[i][j]) {
+            return;
+        }
+
+        arcDelta += (eta > 0.0 ? 1 : 0) - (heuristicPow[i][j] > 0.0 ? 1 : 0);
+        heuristicPow[i][j] = eta;
+        if (!lazyEvaporation) {
+            choiceInfo[i][j] = eta > 0.0 ? trailPower(pheromone.get(i, j)) * eta : 0.0;
+        }
+        dirtyRow[i] = true;
+    };
+
+    refresh(u, v);
+    refresh(v, u);
+    for (int j = 0; j < n; ++j) {
+        const bool usableChanged = usable[j] != oldUsable[j];
+        if (toEnd[j] != oldToEnd[j] || usableChanged) {
+            for (int i = 0; i < n; ++i) {
+                refresh(i, j);
+                if (usableChanged) {
+                    refresh(j, i);
+                }
+            }
+        }
+    }
+    averageDegree += n > 0 ? static_cast<double>(arcDelta) / n : 0.0;
+
+    // Pull the trail on the edge part of the way to the level of its
+    // neighbours, so a cheaper edge gets explored and a dearer one loses
+    // its lead.
+    if (weight > 0.0) {
+        const double tau = pheromone.get(u, v);
+        setTrail(u, v, (1.0 - EDGE_UPDATE_TRAIL_RESET) * tau + EDGE_UPDATE_TRAIL_RESET * localTrailLevel(u, v));
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (!dirtyRow[i]) {
+            continue;
+        }
+        if (candidateListSize > 0) {
+            buildCandidateList(i);
+        }
+        if (smallGraphWords > 0) {
+            buildAdjacencyMask(i);
+        }
+        if (sampling == SamplingMethod::Alias && !aliasTables.empty()) {
+            aliasTables[i].build(choiceInfo[i].data(), n);
+        }
+    }
+
+    revalidateBest(u, v);
+    noImprovement = 0;
+    return true;
+}
+
+bool AntColony::removeEdge(int u, int v) {
+    return setEdgeWeight(u, v, 0.0);
+}
+
+// The best path keeps its length only if it avoids the changed edge: it is
+// re-measured when the edge got a new weight and dropped when it was
+// deleted, after which any path the colony finds counts as an improvement.
+void AntColony::revalidateBest(int u, int v) {
+    bool usesEdge = false;
+    for (size_t k = 0; k + 1 < globalBestPath.size(); ++k) {
+        const int a = globalBestPath[k];
+        const int b = globalBestPath[k + 1];
+        if ((a == u && b == v) || (a == v && b == u)) {
+            usesEdge = true;
+            break;
+        }
+    }
+
+    if (!usesEdge) {
+        return;
+    }
+
+    if (graph->weight(u, v) > 0.0) {
+        globalBestLength = 0.0;
+        for (size_t k = 0; k + 1 < globalBestPath.size(); ++k) {
+            globalBestLength += graph->weight(globalBestPath[k], globalBestPath[k + 1]);
+        }
+        current.bestLength = globalBestLength;
+
+        if (strategy == ACOStrategy::MaxMin) {
+            updateMaxMinBounds();
+        }
+    } else {
+        globalBestPath.clear();
+        globalBestLength = numeric_limits<double>::max();
+        current.pathFound = false;
+        current.bestPath.clear();
+        current.bestLength = numeric_limits<double>::max();
+    }
+}
+
+ACOResult AntColony::run(const ACORunControl& control) {
+    begin();
+
+    while (current.iterations < maxIterations) {
+        const bool improved = iterate();
+        const int it = current.iterations - 1;
+        const double elapsed = elapsedSeconds();
+
+        if (control.wantsProgress(it + 1, improved)) {
+            control.onProgress(ACOProgress{it + 1, elapsed, globalBestLength, globalBestPath, improved});
+        }
+
+        if (logLevel >= LogLevel::Progress && it % 10 == 0) {
+            LogLine line;
+            line << "Iteration " << it + 1;
+            if (current.pathFound) {
+                line << " - Best: " << current.bestLength;
+            } else {
+                line << " - No path found yet";
+            }
+        }
+
+        if (control.shouldStop(current.pathFound, current.bestLength, elapsed, current.stopReason)) {
+            if (logLevel >= LogLevel::Progress) {
+                LogLine() << "Stopped after " << it + 1 << " iterations: "
+                          << stopReasonName(current.stopReason) << ".";
+            }
+            break;
+        }
+
+        if (stagnated()) {
+            current.stopReason = ACOStopReason::Stagnation;
+            if (logLevel >= LogLevel::Progress) {
+                LogLine() << "Stopped early after " << it + 1
+                          << " iterations due to stagnation.";
+            }
+            break;
+        }
+    }
+
+    ACOResult result = finish();
+
+    if (logLevel >= LogLevel::Result) {
+        if (result.pathFound) {
+            LogLine() << "SUCCESS: Path found: " << result.bestPathLabels
+                      << " (length: " << result.bestLength
+                      << ", iterations: " << result.iterations << ")";
+        } else {
+            LogLine() << "FAIL: No path found from " << graph->labels()[start]
+                      << " to " << graph->labels()[end];
+        }
     }
 
     return result;
@@ -1,16 +1,273 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <string>
-#include <random>
+#include <cstdint>
 #include <limits>
+#include <memory>
+#include <chrono>
+#include <atomic>
+#include <functional>
 
+#include "AsyncLog.h"
+#include "ExponentPolicy.h"
+#include "Graph.h"
+#include "PheromoneMatrix.h"
+#include "PhiloxRandom.h"
+#include "RouletteSampler.h"
+
+class ThreadPool;
+class PheromoneStore;
+
+// Vertex set over the first 64 * Words vertices, bit v of word v / 64.
+template <int Words>
+using VertexMask = std::array<std::uint64_t, Words>;
+
+// Ants are pooled across iterations. A vertex counts as visited when its
+// stamp equals the ant's current generation, so reset() never clears the
+// whole set.
 struct Ant {
     std::vector<int> path;
-    std::vector<bool> visited;
+    std::vector<std::uint32_t> visitStamp;
+    std::uint32_t generation;
     double pathLength;
 
+    // Finished by the shortest-path repair rather than by its own walk.
+    bool repaired;
+
+    // Abandoned because it could no longer beat the best path so far.
+    bool pruned;
+
     explicit Ant(int n);
+
+    void reset(int start);
+
+    bool isVisited(int v) const {
+        return visitStamp[v] == generation;
+    }
+
+    void visit(int v) {
+        visitStamp[v] = generation;
+    }
+
+    void unvisit(int v) {
+        visitStamp[v] = generation - 1;
+    }
+};
+
+enum class ACOStrategy {
+    // Every ant deposits, plus extra deposits for the iteration and global best.
+    Elitist,
+    // MAX-MIN Ant System: one best ant deposits, bounds follow the best
+    // length and trails are reset when the colony converges.
+    MaxMin,
+    // Ant Colony System: pseudo-random proportional rule, local updates
+    // while ants walk and a global update from the global best only.
+    ColonySystem
+};
+
+const char* strategyName(ACOStrategy strategy);
+
+// Trail bounds of the elitist update, shared by the dense and sparse
+// colonies; MAX-MIN derives its own from the best length. Trails start at
+// 1: the floor keeps an edge that is never reinforced selectable once
+// evaporation has run its course, and the cap stops the repeated elitist
+// deposits on the incumbent from outweighing a fresh edge more than tenfold.
+const double ELITIST_TAU_MIN = 1e-4;
+const double ELITIST_TAU_MAX = 10.0;
+bool parseStrategy(const std::string& name, ACOStrategy& strategy);
+
+// Returns requested unless it is 0, in which case a seed is drawn from
+// std::random_device.
+std::uint64_t resolveSeed(std::uint64_t requested);
+
+// How selectNext draws from a full row of choice weights (dense engine).
+enum class SamplingMethod {
+    // Masked weights, then a cumulative scan.
+    Linear,
+    // Prefix sums and a binary search.
+    PrefixSum,
+    // Per-vertex Walker alias tables rebuilt with the choice info, with
+    // rejection of visited vertices. Needs the eager choice info, so lazy
+    // evaporation and ACS fall back to PrefixSum.
+    Alias,
+    // SSE2 masking and a branch-free cumulative scan.
+    Simd
+};
+
+enum class HeuristicMode {
+    // eta = 1 / w(i, j).
+    InverseWeight,
+    // eta = 1 / (w(i, j) + d(j, end)) with d from one Dijkstra run from
+    // end, so ants are steered towards the target. Vertices that cannot
+    // reach end get eta = 0.
+    GoalDirected
+};
+
+const char* heuristicName(HeuristicMode mode);
+bool parseHeuristic(const std::string& name, HeuristicMode& mode);
+
+const char* samplingName(SamplingMethod method);
+bool parseSampling(const std::string& name, SamplingMethod& method);
+
+enum class ACOEngine {
+    Dense,
+    Sparse
+};
+
+struct ACOParameters {
+    // Colony implementation chosen by the runners: the dense matrix
+    // AntColony or the CSR-based SparseAntColony.
+    ACOEngine engine = ACOEngine::Dense;
+
+    ACOStrategy strategy = ACOStrategy::Elitist;
+
+    // Core parameters. Zero counts are derived from the graph size:
+    // max(10, n) ants, max(100, 20n) iterations and max(20, n/2)
+    // iterations without improvement before stopping. SparseAntColony uses
+    // fixed defaults instead, see SparseAntColony.cpp.
+    double alpha = 1.0;
+    double beta = 3.0;
+    double evaporation = 0.3;
+    double Q = 100.0;
+    int numAnts = 0;
+    int maxIterations = 0;
+    int stagnationLimit = 0;
+
+    // Ant Colony System: probability of taking the best edge outright and
+    // the local evaporation rate applied to every traversed edge. The usual
+    // TSP value q0 = 0.9 is too greedy for start-end paths, where the
+    // shortest edge often leads into a dead end.
+    double acsQ0 = 0.5;
+    double acsLocalEvaporation = 0.1;
+
+    // Size of the per-vertex nearest-neighbour candidate list, 0 disables it.
+    int candidateListSize = 0;
+
+    // Threads used to construct ants, 0 picks a value from the hardware.
+    int numThreads = 0;
+
+    // Ants each thread moves forward in lockstep, one step per round, with
+    // the row scans running across the batch; rounded up to 8 or 16, 0 or 1
+    // builds ants one at a time. Covers the eager linear roulette without
+    // candidate lists on graphs too large for the bitmask path; ACS and the
+    // other samplers build per ant. Seeded runs give the same results.
+    int antBatch = 0;
+
+    // Evaporate on read from per-edge timestamps instead of sweeping the
+    // whole matrix every iteration. Best combined with candidate lists.
+    bool lazyEvaporation = false;
+
+    SamplingMethod sampling = SamplingMethod::Linear;
+
+    HeuristicMode heuristic = HeuristicMode::InverseWeight;
+
+    // Zero the heuristic of vertices that lie on no simple start-end path
+    // (found with a block-cut tree), so ants never step into them.
+    bool pruneDeadEnds = false;
+
+    // Finish ants that get stuck along the shortest-path tree towards end,
+    // erasing the loops this creates, instead of discarding them.
+    bool repairAnts = false;
+
+    // Abandon an ant as soon as its length plus the shortest distance from
+    // its vertex to end exceeds the best path found so far.
+    bool branchAndBound = false;
+
+    // Anytime limits used by run(): stop once this many seconds have passed
+    // or a path no longer than targetLength is found. 0 disables either.
+    double timeBudget = 0.0;
+    double targetLength = 0.0;
+
+    // Key of the counter-based generator. Runs with the same seed and
+    // parameters produce identical results for any thread count; 0 draws a
+    // fresh seed per colony.
+    std::uint64_t seed = 0;
+
+    // Console output of the colonies and TestRunner, written through
+    // AsyncLog so no I/O happens on the timed path. Sweeps, tuning and
+    // benchmarks turn it off.
+    LogLevel logLevel = LogLevel::Progress;
+};
+
+struct ACOIterationStats {
+    int ants = 0;
+    // Ants that reached end, repaired ones included.
+    int successful = 0;
+    int repaired = 0;
+    // Ants abandoned by the branch-and-bound test. This counts ants, not
+    // construction steps: how many steps an abandoned ant would still
+    // have taken is unknown, so no step total is kept.
+    int pruned = 0;
+    // Best length found so far, max() until the first path.
+    double bestLength = std::numeric_limits<double>::max();
+
+    double successRate() const {
+        return ants > 0 ? static_cast<double>(successful) / ants : 0.0;
+    }
+};
+
+// Why run() returned.
+enum class ACOStopReason {
+    IterationLimit,
+    Stagnation,
+    TimeBudget,
+    TargetReached,
+    Cancelled
+};
+
+const char* stopReasonName(ACOStopReason reason);
+
+// Set by the caller, from any thread, to stop a running colony after its
+// current iteration.
+class CancellationToken {
+public:
+    void cancel() {
+        flag.store(true, std::memory_order_relaxed);
+    }
+
+    bool cancelled() const {
+        return flag.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<bool> flag{false};
+};
+
+// Snapshot handed to the progress callback. bestPath is empty and
+// bestLength is max() until a path has been found.
+struct ACOProgress {
+    int iteration;
+    double elapsed;
+    double bestLength;
+    const std::vector<int>& bestPath;
+    bool improved;
+};
+
+// Stop conditions and progress reporting for an anytime run. All limits
+// are checked once per iteration, so at least one iteration always runs
+// and the budget can be overrun by up to one iteration.
+struct ACORunControl {
+    // Seconds of wall-clock time, 0 for no limit.
+    double timeBudget = 0.0;
+
+    // Stop once the best length is at or below this, 0 for no target.
+    double targetLength = 0.0;
+
+    const CancellationToken* cancel = nullptr;
+
+    // Called on every improvement and, if progressInterval > 0, every
+    // progressInterval iterations. Runs on the thread that called run().
+    std::function<void(const ACOProgress&)> onProgress;
+    int progressInterval = 0;
+
+    bool wantsProgress(int iteration, bool improved) const {
+        return onProgress && (improved || (progressInterval > 0 && iteration % progressInterval == 0));
+    }
+
+    // True, with the reason, when the run should stop after this iteration.
+    bool shouldStop(bool pathFound, double bestLength, double elapsed, ACOStopReason& reason) const;
 };
 
 struct ACOResult {
@@ -20,10 +277,53 @@ struct ACOResult {
     int iterations;
     bool pathFound;
 
+    // Iteration and seconds since the start of run() at which bestLength
+    // was first reached.
+    int bestIteration;
+    double timeToBest;
+
+    // Pheromone resets triggered by MAX-MIN convergence.
+    int restarts;
+
+    // Seed the colony actually ran with.
+    std::uint64_t seed;
+
+    ACOStopReason stopReason;
+
+    // One entry per iteration.
+    std::vector<ACOIterationStats> history;
+
+    // Mean fraction of ants per iteration that reached end.
+    double averageSuccessRate() const {
+        if (history.empty()) {
+            return 0.0;
+        }
+
+        double total = 0.0;
+        for (const auto& stats : history) {
+            total += stats.successRate();
+        }
+        return total / history.size();
+    }
+
+    // Ants abandoned by branch and bound over the whole run.
+    int prunedAnts() const {
+        int total = 0;
+        for (const auto& stats : history) {
+            total += stats.pruned;
+        }
+        return total;
+    }
+
     ACOResult()
         : bestLength(std::numeric_limits<double>::max()),
           iterations(0),
-          pathFound(false) {}
+          pathFound(false),
+          bestIteration(0),
+          timeToBest(0.0),
+          restarts(0),
+          seed(0),
+          stopReason(ACOStopReason::IterationLimit) {}
 };
 
 class AntColony {
@@ -32,37 +332,220 @@ private:
     int start;
     int end;
 
-    std::vector<std::vector<double>> graph;
-    std::vector<std::vector<double>> pheromone;
-    std::vector<std::string> labels;
+    // Shared with the caller and other solvers until setEdgeWeight()
+    // copies it into ownGraph.
+    GraphPtr graph;
+    std::shared_ptr<Graph> ownGraph;
+
+    PheromoneMatrix pheromone;
+    std::vector<std::vector<double>> heuristicPow;
+    std::vector<std::vector<double>> choiceInfo;
+    std::vector<AliasTable> aliasTables;
+    std::vector<std::vector<int>> candidateLists;
+    std::vector<bool> candidateListComplete;
 
     double alpha;
     double beta;
     double evaporation;
     double Q;
 
+    // Kernel variant for tau^alpha, fixed at construction.
+    PowerKind alphaPower;
+
     int numAnts;
     int maxIterations;
     int stagnationLimit;
+    LogLevel logLevel;
+    int candidateListSize;
+    bool lazyEvaporation;
+    ACOStrategy strategy;
+    SamplingMethod sampling;
+    bool repairAnts;
+    HeuristicMode heuristic;
+    bool pruneDeadEnds;
+    bool branchAndBound;
+
+    // Shortest distance from every vertex to end for the goal-directed
+    // heuristic, all zeros otherwise.
+    std::vector<double> toEnd;
+
+    // Vertices left to the ants after dead-end pruning.
+    std::vector<bool> usable;
+
+    // Next hop from every vertex on a shortest path to end, -1 at end and
+    // where end is unreachable. Filled only when repairAnts is set.
+    std::vector<int> towardsEnd;
+
+    // Shortest distance from every vertex to end, the admissible bound for
+    // branch and bound. Empty when branchAndBound is off.
+    std::vector<double> lowerBound;
+
+    double timeBudget;
+    double targetLength;
+
+    double acsQ0;
+    double acsLocalEvaporation;
+    double acsInitialTrail;
 
     double tauMin;
     double tauMax;
+    double averageDegree;
+
+    // Graphs of up to 64 (1) or 128 (2) vertices build ants with bitmask
+    // visited sets; 0 uses the general path. adjacencyMasks[i] has bit j
+    // set where eta(i, j) > 0.
+    int smallGraphWords;
+    std::vector<VertexMask<2>> adjacencyMasks;
+
+    // Lanes of a lockstep batch (8 or 16), 0 builds ants one at a time.
+    int batchLanes;
+
+    // Relative trail levels from PheromoneStore, packed like the pheromone
+    // matrix. Every fill to an initial level is shaped by it; empty means
+    // uniform trails.
+    std::vector<double> warmProfile;
+
+    // Per-thread scratch space. The random stream is re-keyed for every
+    // ant from (iteration, ant index), so it carries no state across ants.
+    struct Worker {
+        PhiloxStream rng;
+        std::vector<double> probabilities;
+
+        // Lockstep batches: visited stamps and masked row weights stored
+        // vertex-major, batchStamps[v * lanes + lane], the generation of
+        // every lane, and a zero row read by idle lanes.
+        std::vector<std::uint32_t> batchStamps;
+        std::vector<double> batchWeights;
+        std::vector<std::uint32_t> batchGenerations;
+        std::vector<double> idleRow;
+    };
+
+    std::uint64_t seed;
+    int iteration;
+
+    int numThreads;
+    std::vector<Worker> workers;
+    std::vector<Ant> ants;
+    std::unique_ptr<ThreadPool> pool;
+
+    std::vector<int> globalBestPath;
+    double globalBestLength;
 
-    std::mt19937 gen;
-    std::uniform_real_distribution<> dist;
+    // State of the run driven by begin(), iterate() and finish().
+    ACOResult current;
+    int noImprovement;
+    bool foundAnyPathEver;
+
+    // Consecutive non-improving iterations with a converged MAX-MIN
+    // branching factor.
+    int convergedIterations;
+    std::chrono::steady_clock::time_point runStart;
 
 private:
-    int selectNext(const Ant& ant, int current);
+    template <typename Power>
+    double choiceWeight(int current, int j, Power power) const;
+    template <typename Power>
+    int selectGreedy(const Ant& ant, int current, Power power) const;
+    int selectNext(const Ant& ant, int current, Worker& worker);
+    template <typename Power>
+    int selectFromCandidates(const Ant& ant, int current, Worker& worker, Power power);
+    template <int MaskWords>
+    void constructAnt(Ant& ant, int antIndex, Worker& worker);
+    template <int MaskWords>
+    int selectSmall(const VertexMask<MaskWords>& visited, int current, Worker& worker);
+    template <int Lanes>
+    void constructBatch(int first, int last, Worker& worker);
+    void buildAdjacencyMask(int i);
+    void constructAnts();
+    void repairAnt(Ant& ant) const;
+    void computeDistances();
+    double heuristicEntry(int i, int j) const;
+    void buildCandidateLists();
+    void buildCandidateList(int i);
     void evaporatePheromones();
-    void clampPheromones();
+    double trailPower(double tau) const;
+    void updateChoiceInfo();
+    template <typename Power>
+    int sampleLazyRow(const Ant& ant, int current, Worker& worker, Power power);
+    void buildAliasTables();
     void depositPath(const std::vector<int>& path, double pathLength, double multiplier = 1.0);
-    std::string buildPathLabels(const std::vector<int>& path) const;
+    void updateElitist(const Ant* iterationBest);
+    bool updateMaxMin(int iteration, const Ant* iterationBest, bool improved, bool firstSolution);
+    void updateMaxMinBounds();
+    double branchingFactor(const std::vector<int>& path) const;
+    double edgesPerStep(const std::vector<int>& path) const;
+    double nearestNeighbourLength() const;
+    void setTrail(int u, int v, double value);
+    void fillTrails(double level);
+    void updateColonySystem();
+    void recordBest();
+    double localTrailLevel(int u, int v) const;
+    void revalidateBest(int u, int v);
+    double elapsedSeconds() const;
 
 public:
-    AntColony(const std::vector<std::vector<double>>& g,
-              const std::vector<std::string>& names,
+    AntColony(GraphPtr g,
               int s,
-              int e);
+              int e,
+              const ACOParameters& params = ACOParameters());
+
+    ~AntColony();
 
+    // Runs with the time budget and target length from ACOParameters.
     ACOResult run();
+
+    // Anytime run: returns the best path found when any limit in control,
+    // maxIterations or stagnation stops it.
+    ACOResult run(const ACORunControl& control);
+
+    // Stepwise interface behind run(), for drivers such as MultiColony that
+    // interleave several colonies. begin() resets the search, iterate() runs
+    // one iteration and reports whether it improved the best path, finish()
+    // returns the result so far. Nothing is logged.
+    void begin();
+    bool iterate();
+    ACOResult finish() const;
+
+    // maxIterations reached, or stagnationLimit iterations without improvement.
+    bool exhausted() const;
+    bool stagnated() const;
+
+    int iterationsDone() const {
+        return current.iterations;
+    }
+
+    const std::vector<int>& bestPath() const {
+        return globalBestPath;
+    }
+
+    double bestLength() const {
+        return globalBestLength;
+    }
+
+    const PheromoneMatrix& trails() const {
+        return pheromone;
+    }
+
+    // Migration from another colony on the same graph. immigrate() adopts
+    // path as the global best when it is shorter and returns whether it
+    // did; blendTrails() sets every edge to (1 - weight) * tau + weight *
+    // the other colony's tau.
+    bool immigrate(const std::vector<int>& path, double length);
+    void blendTrails(const PheromoneMatrix& other, double weight);
+
+    // Changes to a live colony's graph, applied between iterations; the
+    // first one copies the shared graph. A weight of 0 or less deletes the
+    // edge and a positive weight on a missing edge inserts it. The heuristic is updated only where it
+    // changes, the trail on the edge is partly reset, and a best path over
+    // the edge is re-measured or, when the edge is gone, dropped. The
+    // stagnation count restarts, so iterate() keeps searching afterwards.
+    // Returns false when nothing changed.
+    bool setEdgeWeight(int u, int v, double weight);
+    bool removeEdge(int u, int v);
+
+    // Reuse across queries on the same graph: warmStart() shapes the
+    // initial trails by the stored profile and returns false when the
+    // store has none; saveTrails() stores the trails after a run.
+    bool warmStart(PheromoneStore& store);
+    void saveTrails(PheromoneStore& store) const;
 };
\ No newline at end of file
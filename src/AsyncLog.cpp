@@ -0,0 +1,162 @@
+#include "AsyncLog.h"
+
+#include <iostream>
+
+using namespace std;
+
+namespace {
+    // Lines printed before stdout is flushed and progress is published to
+    // flush(), so a steady stream of lines cannot starve it.
+    const int DRAIN_BATCH = 256;
+}
+
+const char* logLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Off: return "off";
+        case LogLevel::Result: return "result";
+        case LogLevel::Progress: break;
+    }
+    return "progress";
+}
+
+bool parseLogLevel(const string& name, LogLevel& level) {
+    if (name == "off") {
+        level = LogLevel::Off;
+        return true;
+    }
+    if (name == "result") {
+        level = LogLevel::Result;
+        return true;
+    }
+    if (name == "progress") {
+        level = LogLevel::Progress;
+        return true;
+    }
+    return false;
+}
+
+AsyncLog& AsyncLog::instance() {
+    static AsyncLog log;
+    return log;
+}
+
+AsyncLog::AsyncLog()
+    : slots(new Slot[CAPACITY]),
+      enqueuePosition(0),
+      dequeuePosition(0),
+      printed(0),
+      stopping(false),
+      sleeping(false)
+{
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        slots[i].sequence.store(i, memory_order_relaxed);
+    }
+
+    drainer = thread(&AsyncLog::drainLoop, this);
+}
+
+AsyncLog::~AsyncLog() {
+    {
+        lock_guard<mutex> lock(wakeMutex);
+        stopping.store(true, memory_order_release);
+    }
+    wakeup.notify_one();
+    drainer.join();
+}
+
+// A slot is free for position p when its sequence is p, and holds the line
+// for p once the producer has stored p + 1.
+void AsyncLog::write(string line) {
+    size_t position = enqueuePosition.load(memory_order_relaxed);
+    Slot* slot = nullptr;
+
+    while (true) {
+        slot = &slots[position % CAPACITY];
+        const size_t sequence = slot->sequence.load(memory_order_acquire);
+        const auto difference = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position);
+
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // Full: the drainer has not yet freed the slot one lap back.
+            this_thread::yield();
+            position = enqueuePosition.load(memory_order_relaxed);
+        } else {
+            position = enqueuePosition.load(memory_order_relaxed);
+        }
+    }
+
+    slot->line = move(line);
+    slot->sequence.store(position + 1, memory_order_release);
+
+    // Pairs with the fence in drainLoop: either the drainer sees this line
+    // before it sleeps, or this sees it sleeping and wakes it.
+    atomic_thread_fence(memory_order_seq_cst);
+    if (sleeping.load(memory_order_relaxed)) {
+        lock_guard<mutex> lock(wakeMutex);
+        wakeup.notify_one();
+    }
+}
+
+bool AsyncLog::ready() const {
+    return slots[dequeuePosition % CAPACITY].sequence.load(memory_order_acquire) == dequeuePosition + 1;
+}
+
+bool AsyncLog::pop(string& line) {
+    if (!ready()) {
+        return false;
+    }
+
+    Slot& slot = slots[dequeuePosition % CAPACITY];
+    line = move(slot.line);
+    slot.line.clear();
+    slot.sequence.store(dequeuePosition + CAPACITY, memory_order_release);
+    dequeuePosition++;
+    return true;
+}
+
+void AsyncLog::flush() {
+    const size_t target = enqueuePosition.load(memory_order_acquire);
+
+    unique_lock<mutex> lock(wakeMutex);
+    drained.wait(lock, [this, target] { return printed.load(memory_order_acquire) >= target; });
+}
+
+void AsyncLog::drainLoop() {
+    string line;
+
+    while (true) {
+        int count = 0;
+        while (count < DRAIN_BATCH && pop(line)) {
+            cout << line << '\n';
+            count++;
+        }
+
+        if (count > 0) {
+            cout.flush();
+            {
+                lock_guard<mutex> lock(wakeMutex);
+                printed.store(dequeuePosition, memory_order_release);
+            }
+            drained.notify_all();
+            continue;
+        }
+
+        // Nothing queued: exit once asked to and every claimed slot has
+        // been published and printed.
+        if (stopping.load(memory_order_acquire) &&
+            enqueuePosition.load(memory_order_acquire) == dequeuePosition) {
+            break;
+        }
+
+        // A claimed slot that is not published yet wakes us on publication,
+        // so sleeping here cannot miss it.
+        unique_lock<mutex> lock(wakeMutex);
+        sleeping.store(true, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        wakeup.wait(lock, [this] { return ready() || stopping.load(memory_order_acquire); });
+        sleeping.store(false, memory_order_relaxed);
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+enum class LogLevel {
+    // Nothing is formatted or queued.
+    Off,
+    // Final result of every run and per-test lines.
+    Result,
+    // Result plus a progress line every 10 iterations.
+    Progress
+};
+
+const char* logLevelName(LogLevel level);
+bool parseLogLevel(const std::string& name, LogLevel& level);
+
+// Process-wide console sink. Producers format a line and push it onto a
+// bounded lock-free ring (Vyukov's sequence-numbered slots); one background
+// thread pops lines and writes them to stdout, so colonies never block on
+// terminal I/O. A producer only waits when the ring is full, and only takes
+// the lock to wake a drainer that has gone to sleep on an empty ring.
+class AsyncLog {
+public:
+    static AsyncLog& instance();
+
+    ~AsyncLog();
+
+    AsyncLog(const AsyncLog&) = delete;
+    AsyncLog& operator=(const AsyncLog&) = delete;
+
+    void write(std::string line);
+
+    // Returns once every line written before the call is on stdout. Call it
+    // before printing to cout directly, so the output stays in order.
+    void flush();
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        std::string line;
+    };
+
+    static const std::size_t CAPACITY = 1024;
+
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<std::size_t> enqueuePosition;
+    std::size_t dequeuePosition;
+    std::atomic<std::size_t> printed;
+    std::atomic<bool> stopping;
+
+    // The drainer sleeps on wakeup while the ring is empty; flush() sleeps
+    // on drained until printed reaches its target.
+    std::mutex wakeMutex;
+    std::condition_variable wakeup;
+    std::condition_variable drained;
+    std::atomic<bool> sleeping;
+
+    std::thread drainer;
+
+    AsyncLog();
+
+    bool ready() const;
+    bool pop(std::string& line);
+    void drainLoop();
+};
+
+// One log line, queued when it goes out of scope:
+//     LogLine() << "Iteration " << it;
+class LogLine {
+public:
+    LogLine() = default;
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    ~LogLine() {
+        AsyncLog::instance().write(stream.str());
+    }
+
+    template <typename T>
+    LogLine& operator<<(const T& value) {
+        stream << value;
+        return *this;
+    }
+
+private:
+    std::ostringstream stream;
+};
@@ -0,0 +1,326 @@
+#include "AutoTuner.h"
+#include "SparseAntColony.h"
+#include "TestRunner.h"
+#include "FileReader.h"
+#include "Dijkstra.h"
+#include "ParameterFile.h"
+#include "ThreadPool.h"
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <numeric>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+    // Fixed so that repeated tuning runs race on the same graphs.
+    const unsigned int SAMPLE_SEED = 20240917u;
+
+    struct Instance {
+        string name;
+        GraphPtr graph;
+        int start = -1;
+        int end = -1;
+        double optimum = 0.0;
+    };
+
+    // Relative error against the optimum (infinite when no path was found)
+    // and wall time of the run.
+    struct Score {
+        double error = numeric_limits<double>::infinity();
+        double time = 0.0;
+    };
+
+    bool scoreLess(const Score& a, const Score& b) {
+        if (fabs(a.error - b.error) > 1e-9) {
+            return a.error < b.error;
+        }
+        return a.time < b.time;
+    }
+
+    bool scoreEqual(const Score& a, const Score& b) {
+        return !scoreLess(a, b) && !scoreLess(b, a);
+    }
+
+    // Abramowitz & Stegun 26.2.23, absolute error below 4.5e-4.
+    double normalQuantile(double p) {
+        const bool upper = p > 0.5;
+        const double q = upper ? 1.0 - p : p;
+        const double t = sqrt(-2.0 * log(q));
+        const double z = t - (2.515517 + 0.802853 * t + 0.010328 * t * t) /
+                             (1.0 + 1.432788 * t + 0.189269 * t * t + 0.001308 * t * t * t);
+        return upper ? z : -z;
+    }
+
+    // Cornish-Fisher expansion of Student's t around the normal quantile.
+    double tQuantile(double p, double df) {
+        const double z = normalQuantile(p);
+        const double z3 = z * z * z;
+        const double z5 = z3 * z * z;
+        const double z7 = z5 * z * z;
+        return z + (z3 + z) / (4.0 * df)
+                 + (5.0 * z5 + 16.0 * z3 + 3.0 * z) / (96.0 * df * df)
+                 + (3.0 * z7 + 19.0 * z5 + 17.0 * z3 - 15.0 * z) / (384.0 * df * df * df);
+    }
+
+    // Wilson-Hilferty approximation.
+    double chiSquareQuantile(double p, double df) {
+        const double z = normalQuantile(p);
+        const double c = 2.0 / (9.0 * df);
+        const double base = 1.0 - c + z * sqrt(c);
+        return df * base * base * base;
+    }
+
+    // 1-based ranks of the scores, ties share their average rank.
+    vector<double> rankScores(const vector<Score>& scores) {
+        const int k = static_cast<int>(scores.size());
+        vector<int> order(k);
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](int a, int b) { return scoreLess(scores[a], scores[b]); });
+
+        vector<double> ranks(k, 0.0);
+        for (int i = 0; i < k;) {
+            int j = i + 1;
+            while (j < k && scoreEqual(scores[order[i]], scores[order[j]])) {
+                j++;
+            }
+
+            const double rank = (i + 1 + j) / 2.0;
+            for (int m = i; m < j; ++m) {
+                ranks[order[m]] = rank;
+            }
+            i = j;
+        }
+
+        return ranks;
+    }
+
+    vector<Instance> sampleInstances(const string& testDirectory, int sampleSize) {
+        vector<string> files = readTestFilesList(testDirectory);
+        shuffle(files.begin(), files.end(), mt19937(SAMPLE_SEED));
+
+        vector<Instance> instances;
+        for (const auto& filename : files) {
+            if (static_cast<int>(instances.size()) >= sampleSize) {
+                break;
+            }
+
+            Instance instance;
+            instance.graph = loadGraph(testDirectory + "/" + filename, instance.start, instance.end);
+
+            if (!instance.graph || instance.start < 0 || instance.end < 0) {
+                continue;
+            }
+
+            const DijkstraResult reference = Dijkstra::findShortestPath(instance.graph->matrix(), {},
+                                                                        instance.start, instance.end);
+            if (!reference.pathFound || reference.bestLength <= 0.0) {
+                continue;
+            }
+
+            instance.name = filename.substr(0, filename.find_last_of('.'));
+            instance.optimum = reference.bestLength;
+            instances.push_back(move(instance));
+        }
+
+        return instances;
+    }
+
+    Score evaluate(const ACOParameters& candidate, const Instance& instance) {
+        ACOParameters params = candidate;
+        params.numThreads = 1;
+        params.logLevel = LogLevel::Off;
+
+        const auto startTime = chrono::steady_clock::now();
+
+        ACOResult result;
+        if (params.engine == ACOEngine::Sparse) {
+            SparseAntColony colony(CsrGraph::fromAdjacencyMatrix(instance.graph->matrix()), instance.graph->labels(),
+                                   instance.start, instance.end, params);
+            result = colony.run();
+        } else {
+            AntColony colony(instance.graph, instance.start, instance.end, params);
+            result = colony.run();
+        }
+
+        Score score;
+        score.time = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+        if (result.pathFound) {
+            score.error = max(0.0, (result.bestLength - instance.optimum) / instance.optimum);
+            if (score.error < 1e-9) {
+                score.error = 0.0;
+            }
+        }
+
+        return score;
+    }
+}
+
+AutoTuner::AutoTuner(string testDirectory, AutoTuneOptions options)
+    : testDirectory(move(testDirectory)),
+      options(move(options)) {}
+
+vector<ACOParameters> AutoTuner::defaultCandidates(const ACOParameters& base) {
+    vector<ParameterAxis> axes = {
+        {"alpha", {"0.5", "1", "2"}},
+        {"beta", {"2", "3", "5"}},
+        {"evaporation", {"0.1", "0.3", "0.5"}}
+    };
+
+    // The sparse engine runs the elitist update only.
+    if (base.engine == ACOEngine::Dense) {
+        axes.push_back({"strategy", {"elitist", "mmas"}});
+    }
+
+    return expandParameterGrid(base, axes);
+}
+
+AutoTuneResult AutoTuner::race(const vector<ACOParameters>& candidates) const {
+    AutoTuneResult result;
+    if (candidates.empty()) {
+        return result;
+    }
+
+    const vector<Instance> instances = sampleInstances(testDirectory, options.sampleSize);
+    if (instances.empty()) {
+        cerr << "Error: no usable graphs for tuning in " << testDirectory << endl;
+        return result;
+    }
+
+    const int count = static_cast<int>(candidates.size());
+    vector<int> alive(count);
+    iota(alive.begin(), alive.end(), 0);
+
+    // scores[t][c] is filled for every candidate alive at instance t; the
+    // survivors therefore have a complete column for the Friedman test.
+    vector<vector<Score>> scores(instances.size(), vector<Score>(count));
+
+    ofstream log;
+    if (!options.logFile.empty()) {
+        fs::create_directories(fs::path(options.logFile).parent_path());
+        log.open(options.logFile);
+        log << "Step,Graph,Survivors,FriedmanStatistic,CriticalValue,Eliminated\n";
+    }
+
+    ThreadPool pool(ThreadPool::resolveThreadCount(options.threads, count, 1));
+
+    cout << "=== ACO Autotune: " << count << " configurations, "
+         << instances.size() << " graphs, " << pool.size() << " threads ===" << endl;
+
+    for (size_t t = 0; t < instances.size() && alive.size() > 1; ++t) {
+        const Instance& instance = instances[t];
+
+        atomic<int> next{0};
+        const int aliveCount = static_cast<int>(alive.size());
+        pool.runOnAll([&](int) {
+            for (int i = next++; i < aliveCount; i = next++) {
+                scores[t][alive[i]] = evaluate(candidates[alive[i]], instance);
+            }
+        });
+
+        result.evaluations += aliveCount;
+        result.instancesUsed = static_cast<int>(t) + 1;
+
+        const int N = static_cast<int>(t) + 1;
+        const int k = aliveCount;
+        double statistic = 0.0;
+        double critical = 0.0;
+        int eliminated = 0;
+
+        if (N >= options.minInstancesBeforeTest) {
+            vector<double> rankSums(k, 0.0);
+            double squaredRanks = 0.0;
+
+            for (int s = 0; s < N; ++s) {
+                vector<Score> row(k);
+                for (int i = 0; i < k; ++i) {
+                    row[i] = scores[s][alive[i]];
+                }
+
+                const vector<double> ranks = rankScores(row);
+                for (int i = 0; i < k; ++i) {
+                    rankSums[i] += ranks[i];
+                    squaredRanks += ranks[i] * ranks[i];
+                }
+            }
+
+            const double tieTerm = N * k * (k + 1.0) * (k + 1.0) / 4.0;
+            const double denominator = squaredRanks - tieTerm;
+
+            if (denominator > 1e-12) {
+                double spread = 0.0;
+                double sumSquaredRankSums = 0.0;
+                for (double r : rankSums) {
+                    spread += (r - N * (k + 1.0) / 2.0) * (r - N * (k + 1.0) / 2.0);
+                    sumSquaredRankSums += r * r;
+                }
+
+                statistic = (k - 1.0) * spread / denominator;
+                critical = chiSquareQuantile(1.0 - options.significance, k - 1.0);
+
+                if (statistic > critical) {
+                    // Conover's post-hoc test against the current leader.
+                    const int leader = static_cast<int>(min_element(rankSums.begin(), rankSums.end()) - rankSums.begin());
+                    const double df = (N - 1.0) * (k - 1.0);
+                    const double margin = df > 0.0
+                        ? tQuantile(1.0 - options.significance / 2.0, df) *
+                          sqrt(max(0.0, 2.0 * (N * squaredRanks - sumSquaredRankSums) / df))
+                        : numeric_limits<double>::infinity();
+
+                    vector<int> survivors;
+                    for (int i = 0; i < k; ++i) {
+                        if (i == leader || rankSums[i] - rankSums[leader] <= margin) {
+                            survivors.push_back(alive[i]);
+                        }
+                    }
+
+                    eliminated = k - static_cast<int>(survivors.size());
+                    alive.swap(survivors);
+                }
+            }
+        }
+
+        cout << "[" << N << "/" << instances.size() << "] " << instance.name
+             << ": " << alive.size() << " configurations left";
+        if (eliminated > 0) {
+            cout << " (dropped " << eliminated << ")";
+        }
+        cout << endl;
+
+        if (log.is_open()) {
+            log << N << "," << instance.name << "," << alive.size() << ","
+                << statistic << "," << critical << "," << eliminated << "\n";
+        }
+    }
+
+    // Winner: lowest rank sum among the survivors over every graph raced.
+    const int N = result.instancesUsed;
+    vector<double> rankSums(alive.size(), 0.0);
+    for (int s = 0; s < N; ++s) {
+        vector<Score> row(alive.size());
+        for (size_t i = 0; i < alive.size(); ++i) {
+            row[i] = scores[s][alive[i]];
+        }
+
+        const vector<double> ranks = rankScores(row);
+        for (size_t i = 0; i < alive.size(); ++i) {
+            rankSums[i] += ranks[i];
+        }
+    }
+
+    const size_t winner = min_element(rankSums.begin(), rankSums.end()) - rankSums.begin();
+    result.bestIndex = alive[winner];
+    result.best = candidates[result.bestIndex];
+    result.survivors = alive;
+
+    return result;
+}
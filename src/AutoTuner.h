@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "AntColony.h"
+
+struct AutoTuneOptions {
+    // Graphs drawn from the test suite; the race visits them one at a time.
+    int sampleSize = 12;
+
+    // Graphs every configuration must see before the first elimination.
+    int minInstancesBeforeTest = 5;
+
+    // Significance level of the Friedman test and its post-hoc comparisons.
+    double significance = 0.05;
+
+    // Threads evaluating configurations, 0 = hardware concurrency.
+    int threads = 0;
+
+    // Per-step log of the race, empty disables it.
+    std::string logFile = "results/autotune_race.csv";
+};
+
+struct AutoTuneResult {
+    ACOParameters best;
+    int bestIndex = -1;
+    int instancesUsed = 0;
+    int evaluations = 0;
+    std::vector<int> survivors;
+};
+
+// F-Race over ACO configurations. Each candidate is run on sampled graphs
+// and scored against the Dijkstra optimum (relative error first, time as a
+// tie-break). After every graph a Friedman test on the ranks decides
+// whether the field differs; if it does, configurations whose rank sum is
+// significantly worse than the leader's are dropped.
+class AutoTuner {
+public:
+    AutoTuner(std::string testDirectory, AutoTuneOptions options = AutoTuneOptions());
+
+    AutoTuneResult race(const std::vector<ACOParameters>& candidates) const;
+
+    // Default search space around the built-in parameters.
+    static std::vector<ACOParameters> defaultCandidates(const ACOParameters& base);
+
+private:
+    std::string testDirectory;
+    AutoTuneOptions options;
+};
@@ -9,29 +9,13 @@
 using namespace std;
 namespace fs = std::filesystem;
 
-BellmanFordSolver::BellmanFordSolver(const vector<vector<double>>& g,
-                                     const vector<string>& names,
-                                     int s,
-                                     int e)
-    : graph(g), labels(names), start(s), end(e) {}
-
-string BellmanFordSolver::buildPathLabels(const vector<int>& path) const {
-    string result;
-
-    for (size_t i = 0; i < path.size(); ++i) {
-        result += labels[path[i]];
-        if (i + 1 < path.size()) {
-            result += " -> ";
-        }
-    }
-
-    return result;
-}
+BellmanFordSolver::BellmanFordSolver(GraphPtr g, int s, int e)
+    : graph(move(g)), start(s), end(e) {}
 
 BellmanFordResult BellmanFordSolver::run() {
     BellmanFordResult result;
 
-    const int n = static_cast<int>(graph.size());
+    const int n = graph->size();
     if (n == 0 || start < 0 || end < 0 || start >= n || end >= n) {
         return result;
     }
@@ -53,9 +37,10 @@ BellmanFordResult BellmanFordSolver::run() {
 
     for (int u = 0; u < n; ++u) {
         for (int v = u + 1; v < n; ++v) {
-            if (graph[u][v] > 0.0) {
-                edges.push_back({u, v, graph[u][v]});
-                edges.push_back({v, u, graph[u][v]});
+            const double w = graph->weight(u, v);
+            if (w > 0.0) {
+                edges.push_back({u, v, w});
+                edges.push_back({v, u, w});
             }
         }
     }
@@ -118,7 +103,7 @@ BellmanFordResult BellmanFordSolver::run() {
     result.bestPath = path;
     result.bestLength = dist[end];
     result.pathFound = true;
-    result.bestPathLabels = buildPathLabels(path);
+    result.bestPathLabels = graph->labels().join(path, " -> ");
 
     return result;
 }
@@ -127,6 +112,10 @@ string BellmanFordTestRunner::getDefaultOutputFile() const {
     return "results/bellman_ford_results.csv";
 }
 
+bool BellmanFordTestRunner::writesAcoColumns() const {
+    return false;
+}
+
 void BellmanFordTestRunner::runTestSuite(const string& testDirectory) {
     clearResults();
 
@@ -178,29 +167,23 @@ void BellmanFordTestRunner::runTestSuite(const string& testDirectory) {
 }
 
 void BellmanFordTestRunner::runSingleTest(const string& graphFile, const string& testName) {
-    bool fileLoaded = false;
-    vector<vector<double>> graph;
-    vector<string> labels;
     int start = -1;
     int end = -1;
 
-    readGraphFromFile(graphFile, fileLoaded, graph, labels, start, end);
+    const GraphPtr graph = loadGraph(graphFile, start, end);
 
-    if (!fileLoaded || graph.empty()) {
+    if (!graph) {
         cerr << "  Failed to load graph: " << graphFile << endl;
         return;
     }
 
-    const int n = static_cast<int>(labels.size());
-    if (n == 0) {
-        cerr << "  Empty graph: " << graphFile << endl;
-        return;
-    }
+    const int n = graph->size();
+    const int edges = countEdges(graph->matrix());
 
-    cout << "  Path: " << labels[start] << " -> " << labels[end];
-    cout << " (vertices: " << n << ", edges: " << countEdges(graph) << ")" << endl;
+    cout << "  Path: " << graph->labels()[start] << " -> " << graph->labels()[end];
+    cout << " (vertices: " << n << ", edges: " << edges << ")" << endl;
 
-    BellmanFordSolver solver(graph, labels, start, end);
+    BellmanFordSolver solver(graph, start, end);
 
     auto startTime = chrono::high_resolution_clock::now();
     BellmanFordResult result = solver.run();
@@ -210,13 +193,7 @@ void BellmanFordTestRunner::runSingleTest(const string& graphFile, const string&
 
     string pathSequence = "NO_PATH";
     if (result.pathFound && !result.bestPath.empty()) {
-        pathSequence.clear();
-        for (size_t i = 0; i < result.bestPath.size(); i++) {
-            pathSequence += labels[result.bestPath[i]];
-            if (i < result.bestPath.size() - 1) {
-                pathSequence += "->";
-            }
-        }
+        pathSequence = graph->labels().join(result.bestPath, "->");
     }
 
     TestResult testResult;
@@ -224,7 +201,7 @@ void BellmanFordTestRunner::runSingleTest(const string& graphFile, const string&
     testResult.executionTime = executionTime;
     testResult.bestPathLength = result.bestLength;
     testResult.vertices = n;
-    testResult.edges = countEdges(graph);
+    testResult.edges = edges;
     testResult.foundPath = result.pathFound;
     testResult.iterations = result.iterations;
     testResult.bestPathSequence = pathSequence;
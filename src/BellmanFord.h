@@ -23,25 +23,20 @@ struct BellmanFordResult {
 
 class BellmanFordSolver {
 public:
-    BellmanFordSolver(const std::vector<std::vector<double>>& g,
-                      const std::vector<std::string>& names,
-                      int s,
-                      int e);
+    BellmanFordSolver(GraphPtr g, int s, int e);
 
     BellmanFordResult run();
 
 private:
-    std::vector<std::vector<double>> graph;
-    std::vector<std::string> labels;
+    GraphPtr graph;
     int start;
     int end;
-
-    std::string buildPathLabels(const std::vector<int>& path) const;
 };
 
 class BellmanFordTestRunner : public TestRunner {
 public:
     std::string getDefaultOutputFile() const override;
+    bool writesAcoColumns() const override;
     void runTestSuite(const std::string& testDirectory) override;
     void runSingleTest(const std::string& graphFile, const std::string& testName) override;
 };
\ No newline at end of file
@@ -0,0 +1,616 @@
+#include "Benchmarks.h"
+#include "TestRunner.h"
+#include "FileReader.h"
+#include "PheromoneStore.h"
+#include "Dijkstra.h"
+#include "GraphGenerator.h"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <filesystem>
+#include <functional>
+#include <chrono>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+    const int DEFAULT_REPEATS = 3;
+    const int DEFAULT_BENCHMARK_ITERATIONS = 200;
+
+    // Warm-start benchmark: queries per graph, drawn from a small pool of
+    // (start, end) pairs so later queries repeat earlier ones.
+    const int WARMSTART_QUERIES = 12;
+    const int WARMSTART_PAIRS = 3;
+
+    // Dynamic benchmark: grid size, length of the update stream, share of
+    // updates aimed at an edge of the current shortest path (the others
+    // rarely change the optimum), share that delete an edge or re-insert a
+    // deleted one, and the iteration cap per re-convergence.
+    const int DYNAMIC_GRID_ROWS = 7;
+    const int DYNAMIC_GRID_COLS = 7;
+    const int DYNAMIC_UPDATES = 40;
+    const double DYNAMIC_ON_PATH_SHARE = 0.5;
+    const double DYNAMIC_DELETE_SHARE = 0.2;
+    const double DYNAMIC_INSERT_SHARE = 0.2;
+    const int DYNAMIC_MAX_ITERATIONS = 300;
+
+    // Exponent benchmark: weights per step (a row of the d50 graphs) and
+    // steps per timing.
+    const int EXPONENT_ROW_LENGTH = 200;
+    const int EXPONENT_STEPS = 20000;
+
+    // Restart check: largest share of MAX-MIN iterations that may end in a
+    // trail reset on any suite graph.
+    const double RESTARTS_MAX_SHARE = 0.1;
+
+    // Batch benchmark: ant batch sizes compared with per-ant construction (0).
+    const vector<int> BATCH_SIZES = {0, 8, 16};
+
+    struct BenchmarkGraph {
+        string name;
+        GraphPtr graph;
+        int start = -1;
+        int end = -1;
+    };
+
+    vector<BenchmarkGraph> loadSuiteGraphs(const string& testDirectory, const string& pattern) {
+        vector<BenchmarkGraph> graphs;
+
+        for (const auto& filename : readTestFilesList(testDirectory)) {
+            if (filename.find(pattern) == string::npos) {
+                continue;
+            }
+
+            BenchmarkGraph entry;
+            entry.graph = loadGraph(testDirectory + "/" + filename, entry.start, entry.end);
+
+            if (entry.graph && entry.start >= 0 && entry.end >= 0) {
+                entry.name = filename.substr(0, filename.find_last_of('.'));
+                graphs.push_back(move(entry));
+            }
+        }
+
+        if (graphs.empty()) {
+            cerr << "Error: no test graphs matching '" << pattern << "' in " << testDirectory << endl;
+        }
+
+        return graphs;
+    }
+
+    // Fixed seed and a fixed number of iterations, so every variant does
+    // the same amount of work; stagnation would otherwise stop variants at
+    // different points.
+    ACOParameters benchmarkParameters(const ACOParameters& base) {
+        ACOParameters params = base;
+        params.logLevel = LogLevel::Off;
+        params.seed = base.seed != 0 ? base.seed : 1;
+        params.maxIterations = base.maxIterations > 0 ? base.maxIterations : DEFAULT_BENCHMARK_ITERATIONS;
+        params.stagnationLimit = params.maxIterations;
+        params.numThreads = base.numThreads > 0 ? base.numThreads : 1;
+        return params;
+    }
+
+    // Best of several runs, to keep scheduler noise out of the comparison.
+    pair<double, ACOResult> timeColony(const BenchmarkGraph& g, const ACOParameters& params, int repeats) {
+        double best = numeric_limits<double>::max();
+        ACOResult result;
+
+        for (int r = 0; r < repeats; ++r) {
+            AntColony colony(g.graph, g.start, g.end, params);
+
+            const auto startTime = chrono::steady_clock::now();
+            result = colony.run();
+            best = min(best, chrono::duration<double>(chrono::steady_clock::now() - startTime).count());
+        }
+
+        return {best, result};
+    }
+
+    int benchmarkSampling(const string& testDirectory, const ACOParameters& base) {
+        const vector<BenchmarkGraph> graphs = loadSuiteGraphs(testDirectory, "_200v_d50");
+        if (graphs.empty()) {
+            return 1;
+        }
+
+        const vector<SamplingMethod> methods = {
+            SamplingMethod::Linear, SamplingMethod::PrefixSum, SamplingMethod::Alias, SamplingMethod::Simd
+        };
+
+        ofstream csv("results/benchmark_sampling.csv");
+        csv << "Graph,Method,Iterations,Ants,Time,Speedup,BestLength\n";
+
+        cout << "=== Sampling benchmark (" << graphs.size() << " graphs, best of " << DEFAULT_REPEATS << ") ===" << endl;
+        cout << setw(28) << "Graph" << setw(10) << "Method" << setw(12) << "Time" << setw(10) << "Speedup"
+             << setw(12) << "Length" << endl;
+
+        for (const auto& g : graphs) {
+            double reference = 0.0;
+
+            for (SamplingMethod method : methods) {
+                ACOParameters params = benchmarkParameters(base);
+                params.sampling = method;
+
+                const auto [time, result] = timeColony(g, params, DEFAULT_REPEATS);
+                if (method == SamplingMethod::Linear) {
+                    reference = time;
+                }
+
+                const double speedup = time > 0.0 ? reference / time : 0.0;
+                const int ants = params.numAnts > 0 ? params.numAnts : max(10, g.graph->size());
+
+                csv << g.name << "," << samplingName(method) << "," << result.iterations << "," << ants << ","
+                    << time << "," << speedup << "," << result.bestLength << "\n";
+
+                cout << setw(28) << g.name << setw(10) << samplingName(method)
+                     << setw(11) << fixed << setprecision(4) << time << "s"
+                     << setw(9) << setprecision(2) << speedup << "x"
+                     << setw(12) << setprecision(4) << result.bestLength << endl;
+            }
+        }
+
+        cout << "Results saved to: results/benchmark_sampling.csv" << endl;
+        return 0;
+    }
+
+    // Optimality is judged against Dijkstra with a relative tolerance.
+    bool isOptimal(double length, double optimum) {
+        return length < numeric_limits<double>::max() && length <= optimum * (1.0 + 1e-9);
+    }
+
+    int benchmarkWarmStart(const string& testDirectory, const ACOParameters& base) {
+        const vector<BenchmarkGraph> graphs = loadSuiteGraphs(testDirectory, "medium");
+        if (graphs.empty()) {
+            return 1;
+        }
+
+        // Stagnation stays on: the point is how soon the colony settles.
+        ACOParameters params = base;
+        params.logLevel = LogLevel::Off;
+        params.seed = base.seed != 0 ? base.seed : 1;
+        params.numThreads = base.numThreads > 0 ? base.numThreads : 1;
+
+        ofstream csv("results/benchmark_warmstart.csv");
+        csv << "Graph,Query,Start,End,Mode,Iterations,BestIteration,Length,Optimal\n";
+
+        cout << "=== Warm-start benchmark (" << graphs.size() << " graphs, " << WARMSTART_QUERIES
+             << " queries over " << WARMSTART_PAIRS << " start/end pairs each) ===" << endl;
+        cout << setw(28) << "Graph" << setw(14) << "Cold iters" << setw(14) << "Warm iters"
+             << setw(12) << "Cold best" << setw(12) << "Warm best" << setw(10) << "Optimal" << endl;
+
+        double coldTotal = 0.0;
+        double warmTotal = 0.0;
+        int repeatedQueries = 0;
+
+        for (const auto& g : graphs) {
+            const int n = g.graph->size();
+            mt19937 rng(static_cast<uint32_t>(params.seed));
+            uniform_int_distribution<int> vertex(0, n - 1);
+
+            vector<pair<int, int>> pool = {{g.start, g.end}};
+            while (static_cast<int>(pool.size()) < WARMSTART_PAIRS) {
+                const int s = vertex(rng);
+                const int e = vertex(rng);
+                if (s != e && Dijkstra::distancesFrom(g.graph->matrix(), e)[s] < numeric_limits<double>::infinity()) {
+                    pool.push_back({s, e});
+                }
+            }
+
+            PheromoneStore store;
+            double coldIterations = 0.0;
+            double warmIterations = 0.0;
+            double coldBest = 0.0;
+            double warmBest = 0.0;
+            int coldOptimal = 0;
+            int warmOptimal = 0;
+
+            for (int q = 0; q < WARMSTART_QUERIES; ++q) {
+                const auto [s, e] = pool[q % pool.size()];
+                const double optimum = Dijkstra::distancesFrom(g.graph->matrix(), e)[s];
+
+                AntColony cold(g.graph, s, e, params);
+                const ACOResult coldResult = cold.run();
+
+                AntColony warm(g.graph, s, e, params);
+                const bool warmed = warm.warmStart(store);
+                const ACOResult warmResult = warm.run();
+                warm.saveTrails(store);
+
+                for (const auto& [mode, result] : {make_pair("cold", &coldResult), make_pair(warmed ? "warm" : "first", &warmResult)}) {
+                    csv << g.name << "," << q << "," << g.graph->labels()[s] << "," << g.graph->labels()[e] << "," << mode << ","
+                        << result->iterations << "," << result->bestIteration << "," << result->bestLength << ","
+                        << (isOptimal(result->bestLength, optimum) ? "true" : "false") << "\n";
+                }
+
+                // The first query has nothing to warm-start from.
+                if (!warmed) {
+                    continue;
+                }
+
+                coldIterations += coldResult.iterations;
+                warmIterations += warmResult.iterations;
+                coldBest += coldResult.bestIteration;
+                warmBest += warmResult.bestIteration;
+                coldOptimal += isOptimal(coldResult.bestLength, optimum);
+                warmOptimal += isOptimal(warmResult.bestLength, optimum);
+                repeatedQueries++;
+            }
+
+            const int warmedQueries = WARMSTART_QUERIES - 1;
+            coldTotal += coldIterations;
+            warmTotal += warmIterations;
+
+            cout << setw(28) << g.name << fixed << setprecision(1)
+                 << setw(14) << coldIterations / warmedQueries << setw(14) << warmIterations / warmedQueries
+                 << setw(12) << coldBest / warmedQueries << setw(12) << warmBest / warmedQueries
+                 << setw(6) << coldOptimal << "/" << warmOptimal << endl;
+        }
+
+        if (repeatedQueries > 0) {
+            cout << "Average iterations on warm-started queries: cold " << setprecision(1)
+                 << coldTotal / repeatedQueries << ", warm " << warmTotal / repeatedQueries << endl;
+        }
+        cout << "Results saved to: results/benchmark_warmstart.csv" << endl;
+        return 0;
+    }
+
+    // Iterations and seconds until the colony's best path is optimal, or
+    // the cap when it never gets there.
+    pair<int, double> iterateToOptimum(AntColony& colony, double optimum) {
+        const auto startTime = chrono::steady_clock::now();
+        int iterations = 0;
+
+        while (!isOptimal(colony.bestLength(), optimum) && iterations < DYNAMIC_MAX_ITERATIONS) {
+            colony.iterate();
+            iterations++;
+        }
+
+        return {iterations, chrono::duration<double>(chrono::steady_clock::now() - startTime).count()};
+    }
+
+    // Replays a seeded stream of weight changes, deletions and re-insertions
+    // on a grid. After every update the live colony (setEdgeWeight) and a
+    // colony built from scratch on the new graph iterate until they hold
+    // the new shortest path.
+    int benchmarkDynamic(const string&, const ACOParameters& base) {
+        ACOParameters params = base;
+        params.logLevel = LogLevel::Off;
+        params.seed = base.seed != 0 ? base.seed : 1;
+        params.numThreads = base.numThreads > 0 ? base.numThreads : 1;
+
+        GraphGenerator generator(static_cast<unsigned int>(params.seed));
+        vector<vector<double>> graph = generator.generateGridGraph(DYNAMIC_GRID_ROWS, DYNAMIC_GRID_COLS);
+        const int n = static_cast<int>(graph.size());
+        const VertexLabels labels;
+        const int start = 0;
+        const int end = n - 1;
+
+        vector<pair<int, int>> edges;
+        for (int u = 0; u < n; ++u) {
+            for (int v = u + 1; v < n; ++v) {
+                if (graph[u][v] > 0.0) {
+                    edges.push_back({u, v});
+                }
+            }
+        }
+
+        AntColony live(make_shared<const Graph>(graph), start, end, params);
+        live.begin();
+        const auto [warmUp, warmUpTime] = iterateToOptimum(live, Dijkstra::distancesFrom(graph, end)[start]);
+
+        ofstream csv("results/benchmark_dynamic.csv");
+        csv << "Update,Change,U,V,OldWeight,NewWeight,Optimum,Mode,Iterations,Time,Length,Optimal\n";
+
+        cout << "=== Dynamic graph benchmark (" << DYNAMIC_GRID_ROWS << "x" << DYNAMIC_GRID_COLS << " grid, "
+             << DYNAMIC_UPDATES << " updates) ===" << endl;
+        cout << "Initial convergence: " << warmUp << " iterations, " << fixed << setprecision(4) << warmUpTime << "s" << endl;
+        cout << setw(8) << "Update" << setw(10) << "Change" << setw(10) << "Optimum"
+             << setw(12) << "Live iters" << setw(12) << "Live time" << setw(12) << "Cold iters" << setw(12) << "Cold time" << endl;
+
+        mt19937 rng(static_cast<uint32_t>(params.seed));
+        uniform_real_distribution<double> unit(0.0, 1.0);
+        uniform_real_distribution<double> weight(1.0, 10.0);
+        vector<pair<int, int>> deleted;
+
+        double liveIterations = 0.0;
+        double coldIterations = 0.0;
+        double liveTime = 0.0;
+        double coldTime = 0.0;
+        int liveOptimal = 0;
+        int coldOptimal = 0;
+
+        for (int k = 0; k < DYNAMIC_UPDATES; ++k) {
+            const double draw = unit(rng);
+            const char* change = "weight";
+            pair<int, int> edge = edges[uniform_int_distribution<size_t>(0, edges.size() - 1)(rng)];
+            if (unit(rng) < DYNAMIC_ON_PATH_SHARE) {
+                const vector<int> path = Dijkstra::findShortestPath(graph, {}, start, end).bestPath;
+                const size_t hop = uniform_int_distribution<size_t>(0, path.size() - 2)(rng);
+                edge = {min(path[hop], path[hop + 1]), max(path[hop], path[hop + 1])};
+            }
+            double newWeight = weight(rng);
+
+            if (draw < DYNAMIC_INSERT_SHARE && !deleted.empty()) {
+                change = "insert";
+                edge = deleted.back();
+                deleted.pop_back();
+            } else if (draw < DYNAMIC_INSERT_SHARE + DYNAMIC_DELETE_SHARE && graph[edge.first][edge.second] > 0.0) {
+                // Only deletions that keep end reachable.
+                const double oldWeight = graph[edge.first][edge.second];
+                graph[edge.first][edge.second] = graph[edge.second][edge.first] = 0.0;
+                const bool reachable = Dijkstra::distancesFrom(graph, end)[start] < numeric_limits<double>::infinity();
+                graph[edge.first][edge.second] = graph[edge.second][edge.first] = oldWeight;
+
+                if (reachable) {
+                    change = "delete";
+                    newWeight = 0.0;
+                    deleted.push_back(edge);
+                }
+            } else if (graph[edge.first][edge.second] <= 0.0) {
+                change = "insert";
+                deleted.erase(remove(deleted.begin(), deleted.end(), edge), deleted.end());
+            }
+
+            const auto [u, v] = edge;
+            const double oldWeight = graph[u][v];
+            graph[u][v] = graph[v][u] = newWeight;
+            const double optimum = Dijkstra::distancesFrom(graph, end)[start];
+
+            live.setEdgeWeight(u, v, newWeight);
+            const auto [liveIters, liveSeconds] = iterateToOptimum(live, optimum);
+
+            AntColony cold(make_shared<const Graph>(graph), start, end, params);
+            cold.begin();
+            const auto [coldIters, coldSeconds] = iterateToOptimum(cold, optimum);
+
+            for (const auto& [mode, colony, iters, seconds] : {make_tuple("live", &live, liveIters, liveSeconds),
+                                                               make_tuple("cold", &cold, coldIters, coldSeconds)}) {
+                csv << k << "," << change << "," << labels[u] << "," << labels[v] << "," << oldWeight << "," << newWeight << ","
+                    << optimum << "," << mode << "," << iters << "," << seconds << "," << colony->bestLength() << ","
+                    << (isOptimal(colony->bestLength(), optimum) ? "true" : "false") << "\n";
+            }
+
+            liveIterations += liveIters;
+            coldIterations += coldIters;
+            liveTime += liveSeconds;
+            coldTime += coldSeconds;
+            liveOptimal += isOptimal(live.bestLength(), optimum);
+            coldOptimal += isOptimal(cold.bestLength(), optimum);
+
+            cout << setw(8) << k << setw(10) << change << setw(10) << setprecision(2) << optimum
+                 << setw(12) << liveIters << setw(11) << setprecision(4) << liveSeconds << "s"
+                 << setw(12) << coldIters << setw(11) << coldSeconds << "s" << endl;
+        }
+
+        cout << "Average per update: live " << setprecision(1) << liveIterations / DYNAMIC_UPDATES << " iterations, "
+             << setprecision(4) << liveTime / DYNAMIC_UPDATES << "s (" << liveOptimal << " optimal); cold "
+             << setprecision(1) << coldIterations / DYNAMIC_UPDATES << " iterations, "
+             << setprecision(4) << coldTime / DYNAMIC_UPDATES << "s (" << coldOptimal << " optimal)" << endl;
+        cout << "Results saved to: results/benchmark_dynamic.csv" << endl;
+        return 0;
+    }
+
+    // One step's row of tau^alpha * eta, the weights selectNext draws from
+    // with lazy evaporation and updateChoiceInfo fills per row. Returns the
+    // best seconds per step over the repeats.
+    template <typename Power>
+    double timeExponentKernel(Power power, const vector<double>& tau, const vector<double>& eta,
+                              vector<double>& weights, double& checksum) {
+        double best = numeric_limits<double>::max();
+
+        for (int r = 0; r < DEFAULT_REPEATS; ++r) {
+            const auto startTime = chrono::steady_clock::now();
+            for (int step = 0; step < EXPONENT_STEPS; ++step) {
+                for (int j = 0; j < EXPONENT_ROW_LENGTH; ++j) {
+                    weights[j] = power(tau[j]) * eta[j];
+                }
+                checksum += weights[step % EXPONENT_ROW_LENGTH];
+            }
+            best = min(best, chrono::duration<double>(chrono::steady_clock::now() - startTime).count());
+        }
+
+        return best / EXPONENT_STEPS;
+    }
+
+    // std::pow against the kernel ExponentPolicy selects, for the integer
+    // alphas tuned configurations use and one fractional control.
+    int benchmarkExponents(const string&, const ACOParameters& base) {
+        mt19937 rng(static_cast<uint32_t>(base.seed != 0 ? base.seed : 1));
+        uniform_real_distribution<double> trail(1e-3, 10.0);
+        uniform_real_distribution<double> heuristic(1e-3, 1.0);
+
+        vector<double> tau(EXPONENT_ROW_LENGTH);
+        vector<double> eta(EXPONENT_ROW_LENGTH);
+        vector<double> weights(EXPONENT_ROW_LENGTH);
+        for (int j = 0; j < EXPONENT_ROW_LENGTH; ++j) {
+            tau[j] = trail(rng);
+            eta[j] = heuristic(rng);
+        }
+
+        ofstream csv("results/benchmark_exponents.csv");
+        csv << "Alpha,Kernel,NsPerStep,StdPowNsPerStep,Speedup\n";
+
+        cout << "=== Exponent kernel benchmark (" << EXPONENT_ROW_LENGTH << " weights per step, best of "
+             << DEFAULT_REPEATS << ") ===" << endl;
+        cout << setw(8) << "Alpha" << setw(10) << "Kernel" << setw(14) << "std::pow" << setw(14) << "Policy"
+             << setw(10) << "Speedup" << endl;
+
+        double checksum = 0.0;
+        for (double alpha : {1.0, 2.0, 3.0, 4.0, 1.5}) {
+            // Read back through a volatile so the compiler cannot fold the
+            // exponent into the std::pow baseline.
+            volatile double runtimeAlpha = alpha;
+            const double exponent = runtimeAlpha;
+            const PowerKind kind = powerKind(exponent);
+
+            const double generic = timeExponentKernel(GenericPower{exponent}, tau, eta, weights, checksum);
+            const double policy = dispatchPower(kind, exponent, [&](auto power) {
+                return timeExponentKernel(power, tau, eta, weights, checksum);
+            });
+            const double speedup = policy > 0.0 ? generic / policy : 0.0;
+            const char* kernel = kind == PowerKind::Generic ? "pow" : "multiply";
+
+            csv << exponent << "," << kernel << "," << policy * 1e9 << "," << generic * 1e9 << "," << speedup << "\n";
+
+            cout << setw(8) << fixed << setprecision(1) << exponent << setw(10) << kernel
+                 << setw(11) << setprecision(1) << generic * 1e9 << " ns" << setw(11) << policy * 1e9 << " ns"
+                 << setw(9) << setprecision(2) << speedup << "x" << endl;
+        }
+
+        // Keeps the kernels from being optimised away.
+        if (checksum == 0.0) {
+            cout << "Checksum: " << checksum << endl;
+        }
+        cout << "Results saved to: results/benchmark_exponents.csv" << endl;
+        return 0;
+    }
+
+    // Fails when MAX-MIN resets its trails on more than RESTARTS_MAX_SHARE
+    // of the iterations of any suite graph: restarts are meant for a colony
+    // that has really converged, not for every quiet iteration.
+    int benchmarkRestarts(const string& testDirectory, const ACOParameters& base) {
+        const vector<BenchmarkGraph> graphs = loadSuiteGraphs(testDirectory, "test_");
+        if (graphs.empty()) {
+            return 1;
+        }
+
+        // The suite's own iteration and stagnation limits: restarts are
+        // judged over the runs users actually get.
+        ACOParameters params = base;
+        params.strategy = ACOStrategy::MaxMin;
+        params.logLevel = LogLevel::Off;
+        params.seed = base.seed != 0 ? base.seed : 1;
+        params.numThreads = base.numThreads > 0 ? base.numThreads : 1;
+
+        ofstream csv("results/benchmark_restarts.csv");
+        csv << "Graph,Iterations,Restarts,Share,BestLength\n";
+
+        cout << "=== MAX-MIN restart check (" << graphs.size() << " graphs, at most "
+             << RESTARTS_MAX_SHARE * 100.0 << "% of iterations) ===" << endl;
+
+        int failed = 0;
+        double worstShare = 0.0;
+        string worstGraph;
+
+        for (const auto& g : graphs) {
+            AntColony colony(g.graph, g.start, g.end, params);
+            const ACOResult result = colony.run();
+
+            const double share = result.iterations > 0 ? static_cast<double>(result.restarts) / result.iterations : 0.0;
+            csv << g.name << "," << result.iterations << "," << result.restarts << "," << share << ","
+                << result.bestLength << "\n";
+
+            if (share > worstShare) {
+                worstShare = share;
+                worstGraph = g.name;
+            }
+            if (share > RESTARTS_MAX_SHARE) {
+                failed++;
+                cout << "  FAIL " << g.name << ": " << result.restarts << " restarts in "
+                     << result.iterations << " iterations" << endl;
+            }
+        }
+
+        cout << "Highest share: " << fixed << setprecision(3) << worstShare;
+        if (!worstGraph.empty()) {
+            cout << " (" << worstGraph << ")";
+        }
+        cout << endl;
+        cout << (failed == 0 ? "PASS" : "FAIL") << ": " << failed << " of " << graphs.size()
+             << " graphs above the limit" << endl;
+        cout << "Results saved to: results/benchmark_restarts.csv" << endl;
+
+        return failed == 0 ? 0 : 1;
+    }
+
+    // Seeded batches choose the same vertices, so the lengths must agree
+    // and only the time differs.
+    int benchmarkBatch(const string& testDirectory, const ACOParameters& base) {
+        const vector<BenchmarkGraph> graphs = loadSuiteGraphs(testDirectory, "_200v_");
+        if (graphs.empty()) {
+            return 1;
+        }
+
+        ofstream csv("results/benchmark_batch.csv");
+        csv << "Graph,Batch,Iterations,Ants,Time,Speedup,BestLength\n";
+
+        cout << "=== Ant batch benchmark (" << graphs.size() << " graphs, best of " << DEFAULT_REPEATS << ") ===" << endl;
+        cout << setw(28) << "Graph" << setw(10) << "Batch" << setw(12) << "Time" << setw(10) << "Speedup"
+             << setw(12) << "Length" << endl;
+
+        for (const auto& g : graphs) {
+            double reference = 0.0;
+
+            for (int batch : BATCH_SIZES) {
+                ACOParameters params = benchmarkParameters(base);
+                params.antBatch = batch;
+
+                const auto [time, result] = timeColony(g, params, DEFAULT_REPEATS);
+                if (batch == 0) {
+                    reference = time;
+                }
+
+                const double speedup = time > 0.0 ? reference / time : 0.0;
+                const int ants = params.numAnts > 0 ? params.numAnts : max(10, g.graph->size());
+                const string label = batch == 0 ? "per-ant" : to_string(batch);
+
+                csv << g.name << "," << label << "," << result.iterations << "," << ants << ","
+                    << time << "," << speedup << "," << result.bestLength << "\n";
+
+                cout << setw(28) << g.name << setw(10) << label
+                     << setw(11) << fixed << setprecision(4) << time << "s"
+                     << setw(9) << setprecision(2) << speedup << "x"
+                     << setw(12) << setprecision(4) << result.bestLength << endl;
+            }
+        }
+
+        cout << "Results saved to: results/benchmark_batch.csv" << endl;
+        return 0;
+    }
+
+    struct BenchmarkEntry {
+        const char* name;
+        const char* description;
+        function<int(const string&, const ACOParameters&)> run;
+    };
+
+    const vector<BenchmarkEntry>& benchmarks() {
+        static const vector<BenchmarkEntry> entries = {
+            {"sampling", "roulette-wheel methods on the 200-vertex d50 graphs", benchmarkSampling},
+            {"warmstart", "repeated queries with and without PheromoneStore warm starts", benchmarkWarmStart},
+            {"dynamic", "re-convergence after edge updates on a live colony vs a restart", benchmarkDynamic},
+            {"exponents", "integer-alpha kernels against std::pow per construction step", benchmarkExponents},
+            {"batch", "lockstep ant batches of 8 and 16 against per-ant construction in run()", benchmarkBatch},
+            {"restarts", "check that MAX-MIN trail resets stay rare on the whole suite", benchmarkRestarts}
+        };
+        return entries;
+    }
+}
+
+int runBenchmark(const string& name, const string& testDirectory, const ACOParameters& base) {
+    fs::create_directories("results");
+
+    for (const auto& entry : benchmarks()) {
+        if (name == entry.name) {
+            return entry.run(testDirectory, base);
+        }
+    }
+
+    cerr << "Unknown benchmark: " << name << endl;
+    printBenchmarkList();
+    return 1;
+}
+
+void printBenchmarkList() {
+    cout << "Benchmarks:\n";
+    for (const auto& entry : benchmarks()) {
+        cout << "  " << left << setw(12) << entry.name << right << entry.description << "\n";
+    }
+}
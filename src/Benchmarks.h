@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+#include "AntColony.h"
+
+// Performance benchmarks selected with ./aco --benchmark <name>. Each one
+// prints a table and writes results/benchmark_<name>.csv. base supplies
+// the colony parameters the benchmark does not vary itself.
+int runBenchmark(const std::string& name, const std::string& testDirectory, const ACOParameters& base);
+
+void printBenchmarkList();
@@ -0,0 +1,150 @@
+#include "BlockCutTree.h"
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+using namespace std;
+
+BlockCutTree::BlockCutTree(const vector<vector<double>>& graph, int root)
+    : n(static_cast<int>(graph.size())),
+      blocksOfVertex(graph.size())
+{
+    if (root < 0 || root >= n) {
+        return;
+    }
+
+    // Iterative Hopcroft-Tarjan: tree and back edges go on an edge stack,
+    // and a block is popped when a child cannot reach above its parent.
+    struct Frame {
+        int v;
+        int parent;
+        int next;
+    };
+
+    vector<int> disc(n, -1);
+    vector<int> low(n, 0);
+    vector<int> mark(n, -1);
+    vector<Frame> frames;
+    vector<pair<int, int>> edges;
+    int time = 0;
+
+    disc[root] = low[root] = time++;
+    frames.push_back({root, -1, 0});
+
+    while (!frames.empty()) {
+        Frame& frame = frames.back();
+        const int v = frame.v;
+
+        if (frame.next < n) {
+            const int w = frame.next++;
+            if (w == v || graph[v][w] <= 0) {
+                continue;
+            }
+
+            if (disc[w] == -1) {
+                edges.push_back({v, w});
+                disc[w] = low[w] = time++;
+                frames.push_back({w, v, 0});
+            } else if (w != frame.parent && disc[w] < disc[v]) {
+                edges.push_back({v, w});
+                low[v] = min(low[v], disc[w]);
+            }
+            continue;
+        }
+
+        const int parent = frame.parent;
+        frames.pop_back();
+
+        if (parent == -1) {
+            continue;
+        }
+
+        low[parent] = min(low[parent], low[v]);
+
+        if (low[v] >= disc[parent]) {
+            const int id = static_cast<int>(blocks.size());
+            blocks.emplace_back();
+
+            while (!edges.empty()) {
+                const pair<int, int> edge = edges.back();
+                edges.pop_back();
+
+                for (int x : {edge.first, edge.second}) {
+                    if (mark[x] != id) {
+                        mark[x] = id;
+                        blocks[id].push_back(x);
+                        blocksOfVertex[x].push_back(id);
+                    }
+                }
+
+                if (edge.first == parent && edge.second == v) {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+vector<bool> BlockCutTree::verticesOnSimplePaths(int start, int end) const {
+    vector<bool> onPath(n, false);
+
+    if (start < 0 || end < 0 || start >= n || end >= n ||
+        blocksOfVertex[start].empty() || blocksOfVertex[end].empty()) {
+        return onPath;
+    }
+
+    // Tree nodes: blocks are 0..B-1, cut vertex v is B + v.
+    const int blockTotal = blockCount();
+    auto nodeOf = [&](int v) {
+        return blocksOfVertex[v].size() > 1 ? blockTotal + v : blocksOfVertex[v][0];
+    };
+
+    const int source = nodeOf(start);
+    const int target = nodeOf(end);
+
+    vector<int> parent(blockTotal + n, -2);
+    queue<int> pending;
+    parent[source] = -1;
+    pending.push(source);
+
+    while (!pending.empty() && parent[target] == -2) {
+        const int node = pending.front();
+        pending.pop();
+
+        auto reach = [&](int next) {
+            if (parent[next] == -2) {
+                parent[next] = node;
+                pending.push(next);
+            }
+        };
+
+        if (node < blockTotal) {
+            for (int v : blocks[node]) {
+                if (blocksOfVertex[v].size() > 1) {
+                    reach(blockTotal + v);
+                }
+            }
+        } else {
+            for (int b : blocksOfVertex[node - blockTotal]) {
+                reach(b);
+            }
+        }
+    }
+
+    if (parent[target] == -2) {
+        return onPath;
+    }
+
+    for (int node = target; node != -1; node = parent[node]) {
+        if (node < blockTotal) {
+            for (int v : blocks[node]) {
+                onPath[v] = true;
+            }
+        } else {
+            onPath[node - blockTotal] = true;
+        }
+    }
+
+    return onPath;
+}
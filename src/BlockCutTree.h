@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+
+// Biconnected components (blocks) of an undirected graph and the tree that
+// links them through articulation points.
+//
+// A vertex lies on some simple start-end path exactly when it belongs to a
+// block on the tree path between start and end: inside a block any two
+// vertices are joined through any third by a simple path, and a block off
+// that tree path can only be left through the cut vertex it was entered
+// by.
+class BlockCutTree {
+public:
+    // Graph as an adjacency matrix, edge (u, v) present when graph[u][v] > 0.
+    // Only the component of root is decomposed.
+    BlockCutTree(const std::vector<std::vector<double>>& graph, int root);
+
+    // onSimplePath[v] is true when v lies on at least one simple start-end
+    // path. All false when end is not reachable from start.
+    std::vector<bool> verticesOnSimplePaths(int start, int end) const;
+
+    int blockCount() const {
+        return static_cast<int>(blocks.size());
+    }
+
+private:
+    int n;
+    std::vector<std::vector<int>> blocks;
+    std::vector<std::vector<int>> blocksOfVertex;
+};
@@ -0,0 +1,66 @@
+#include "CsrGraph.h"
+
+using namespace std;
+
+CsrGraph CsrGraph::fromEdgeList(int vertices, const vector<CsrEdge>& edges) {
+    CsrGraph csr;
+    csr.vertexCount = vertices;
+    csr.offsets.assign(vertices + 1, 0);
+
+    vector<CsrEdge> kept;
+    kept.reserve(edges.size());
+
+    for (const auto& edge : edges) {
+        if (edge.u == edge.v || edge.weight <= 0.0 ||
+            edge.u < 0 || edge.v < 0 || edge.u >= vertices || edge.v >= vertices) {
+            continue;
+        }
+        kept.push_back(edge);
+        csr.offsets[edge.u + 1]++;
+        csr.offsets[edge.v + 1]++;
+    }
+
+    for (int v = 0; v < vertices; ++v) {
+        csr.offsets[v + 1] += csr.offsets[v];
+    }
+
+    csr.edgeCount = static_cast<int>(kept.size());
+    const int arcCount = csr.offsets[vertices];
+    csr.targets.resize(arcCount);
+    csr.weights.resize(arcCount);
+    csr.edgeIds.resize(arcCount);
+
+    vector<int> cursor(csr.offsets.begin(), csr.offsets.end() - 1);
+
+    for (int id = 0; id < csr.edgeCount; ++id) {
+        const CsrEdge& edge = kept[id];
+
+        int arc = cursor[edge.u]++;
+        csr.targets[arc] = edge.v;
+        csr.weights[arc] = edge.weight;
+        csr.edgeIds[arc] = id;
+
+        arc = cursor[edge.v]++;
+        csr.targets[arc] = edge.u;
+        csr.weights[arc] = edge.weight;
+        csr.edgeIds[arc] = id;
+    }
+
+    return csr;
+}
+
+CsrGraph CsrGraph::fromAdjacencyMatrix(const vector<vector<double>>& matrix) {
+    const int n = static_cast<int>(matrix.size());
+    vector<CsrEdge> edges;
+
+    for (int u = 0; u < n; ++u) {
+        for (int v = u + 1; v < n; ++v) {
+            const double w = matrix[u][v] > 0.0 ? matrix[u][v] : matrix[v][u];
+            if (w > 0.0) {
+                edges.push_back({u, v, w});
+            }
+        }
+    }
+
+    return fromEdgeList(n, edges);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+struct CsrEdge {
+    int u;
+    int v;
+    double weight;
+};
+
+// Undirected weighted graph in compressed sparse row form. Both arcs of an
+// edge share the edge id, which indexes per-edge data such as pheromone.
+struct CsrGraph {
+    int vertexCount = 0;
+    int edgeCount = 0;
+
+    std::vector<int> offsets;
+    std::vector<int> targets;
+    std::vector<double> weights;
+    std::vector<int> edgeIds;
+
+    int degree(int v) const {
+        return offsets[v + 1] - offsets[v];
+    }
+
+    static CsrGraph fromEdgeList(int vertices, const std::vector<CsrEdge>& edges);
+    static CsrGraph fromAdjacencyMatrix(const std::vector<std::vector<double>>& matrix);
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include "TestRunner.h"
+#include "CsrGraph.h"
 #include <iostream>
 #include <vector>
 #include <string>
@@ -19,6 +20,77 @@ struct DijkstraResult {
 
 class Dijkstra {
 public:
+    // Distances from source to every vertex, infinity where unreachable.
+    // The graphs are undirected, so these are also the distances to source,
+    // and parent (if given) is the next hop on a shortest path to source.
+    static vector<double> distancesFrom(const vector<vector<double>>& graph, int source,
+                                        vector<int>* parent = nullptr) {
+        const int n = graph.size();
+        vector<double> dist(n, numeric_limits<double>::infinity());
+        vector<bool> visited(n, false);
+
+        if (parent) {
+            parent->assign(n, -1);
+        }
+
+        priority_queue<pair<double, int>, vector<pair<double, int>>, greater<pair<double, int>>> pq;
+
+        dist[source] = 0.0;
+        pq.push({ 0.0, source });
+
+        while (!pq.empty()) {
+            const double currentDist = pq.top().first;
+            const int current = pq.top().second;
+            pq.pop();
+
+            if (visited[current]) continue;
+            visited[current] = true;
+
+            for (int neighbor = 0; neighbor < n; neighbor++) {
+                if (graph[current][neighbor] > 0 && !visited[neighbor] &&
+                    currentDist + graph[current][neighbor] < dist[neighbor]) {
+                    dist[neighbor] = currentDist + graph[current][neighbor];
+                    if (parent) {
+                        (*parent)[neighbor] = current;
+                    }
+                    pq.push({ dist[neighbor], neighbor });
+                }
+            }
+        }
+
+        return dist;
+    }
+
+    static vector<double> distancesFrom(const CsrGraph& graph, int source) {
+        const int n = graph.vertexCount;
+        vector<double> dist(n, numeric_limits<double>::infinity());
+        vector<bool> visited(n, false);
+
+        priority_queue<pair<double, int>, vector<pair<double, int>>, greater<pair<double, int>>> pq;
+
+        dist[source] = 0.0;
+        pq.push({ 0.0, source });
+
+        while (!pq.empty()) {
+            const double currentDist = pq.top().first;
+            const int current = pq.top().second;
+            pq.pop();
+
+            if (visited[current]) continue;
+            visited[current] = true;
+
+            for (int arc = graph.offsets[current]; arc < graph.offsets[current + 1]; ++arc) {
+                const int neighbor = graph.targets[arc];
+                if (!visited[neighbor] && currentDist + graph.weights[arc] < dist[neighbor]) {
+                    dist[neighbor] = currentDist + graph.weights[arc];
+                    pq.push({ dist[neighbor], neighbor });
+                }
+            }
+        }
+
+        return dist;
+    }
+
     static DijkstraResult findShortestPath(const vector<vector<double>>& graph,
         const vector<string>& labels,
         int start, int end) {
@@ -75,6 +147,10 @@ public:
 
 class DijkstraTestRunner : public TestRunner {
 public:
+    bool writesAcoColumns() const override {
+        return false;
+    }
+
     void runSingleTest(const string& graphFile, const string& testName) override {
         bool fileLoaded;
         vector<vector<double>> graph;
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cmath>
+
+// Power functions for the trail exponent. Tuned configurations almost
+// always use a small integer alpha, for which repeated multiplication is
+// several times cheaper than std::pow; any other exponent uses
+// GenericPower. Kernels are templated on the policy and the colony picks
+// it once, at construction, so the choice costs one switch per kernel call
+// (a row or candidate scan, a matrix refresh) rather than one per weight.
+template <int E>
+struct IntegerPower {
+    static_assert(E >= 1, "IntegerPower needs a positive exponent");
+
+    constexpr double operator()(double x) const {
+        return IntegerPower<E - 1>()(x) * x;
+    }
+};
+
+template <>
+struct IntegerPower<1> {
+    constexpr double operator()(double x) const {
+        return x;
+    }
+};
+
+struct GenericPower {
+    double exponent;
+
+    double operator()(double x) const {
+        return std::pow(x, exponent);
+    }
+};
+
+enum class PowerKind {
+    One,
+    Two,
+    Three,
+    Four,
+    Generic
+};
+
+inline PowerKind powerKind(double exponent) {
+    if (exponent == 1.0) {
+        return PowerKind::One;
+    }
+    if (exponent == 2.0) {
+        return PowerKind::Two;
+    }
+    if (exponent == 3.0) {
+        return PowerKind::Three;
+    }
+    if (exponent == 4.0) {
+        return PowerKind::Four;
+    }
+    return PowerKind::Generic;
+}
+
+// Calls kernel with the policy for kind; exponent is only read by the
+// generic fallback.
+template <typename Kernel>
+auto dispatchPower(PowerKind kind, double exponent, Kernel&& kernel) {
+    switch (kind) {
+        case PowerKind::One: return kernel(IntegerPower<1>());
+        case PowerKind::Two: return kernel(IntegerPower<2>());
+        case PowerKind::Three: return kernel(IntegerPower<3>());
+        case PowerKind::Four: return kernel(IntegerPower<4>());
+        case PowerKind::Generic: break;
+    }
+    return kernel(GenericPower{exponent});
+}
@@ -217,4 +217,79 @@ void readGraphFromFile(const string& filename,
     if (end < 0 || end >= n) {
         end = n - 1;
     }
-}
\ No newline at end of file
+}
+
+GraphPtr loadGraph(const string& filename, int& start, int& end) {
+    bool fileLoaded = false;
+    vector<vector<double>> matrix;
+    vector<string> labels;
+
+    readGraphFromFile(filename, fileLoaded, matrix, labels, start, end);
+
+    if (!fileLoaded || matrix.empty()) {
+        return nullptr;
+    }
+    return make_shared<const Graph>(move(matrix), VertexLabels(move(labels)));
+}
+
+bool isEdgeListFile(const string& filename) {
+    const string extension = ".edges";
+    return filename.size() >= extension.size() &&
+           filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+bool loadEdgeList(const string& filename, CsrGraph& graph, int& start, int& end) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: cannot open file " << filename << endl;
+        return false;
+    }
+
+    int vertices = -1;
+    vector<CsrEdge> edges;
+    string line;
+    int lineNumber = 0;
+
+    while (getline(file, line)) {
+        lineNumber++;
+
+        const size_t comment = line.find('#');
+        if (comment != string::npos) {
+            line.erase(comment);
+        }
+        if (trim(line).empty()) {
+            continue;
+        }
+
+        istringstream tokens(line);
+        string extra;
+
+        if (vertices < 0) {
+            if (!(tokens >> vertices >> start >> end) || (tokens >> extra) || vertices <= 0) {
+                cerr << "Error: first line must be 'vertices start end' in " << filename << endl;
+                return false;
+            }
+            if (start < 0 || start >= vertices || end < 0 || end >= vertices) {
+                cerr << "Error: start or end vertex out of range in " << filename << endl;
+                return false;
+            }
+            continue;
+        }
+
+        CsrEdge edge;
+        if (!(tokens >> edge.u >> edge.v >> edge.weight) || (tokens >> extra) ||
+            edge.u < 0 || edge.v < 0 || edge.u >= vertices || edge.v >= vertices) {
+            cerr << "Error: malformed edge on line " << lineNumber << " of " << filename << endl;
+            return false;
+        }
+        edges.push_back(edge);
+    }
+
+    if (vertices < 0) {
+        cerr << "Error: empty edge-list file " << filename << endl;
+        return false;
+    }
+
+    graph = CsrGraph::fromEdgeList(vertices, edges);
+    return true;
+}
@@ -4,6 +4,21 @@
 #include <sstream>
 #include <vector>
 
+#include "CsrGraph.h"
+#include "Graph.h"
+
 using namespace std;
 
-void readGraphFromFile(const string& filename, bool& fileLoaded, vector<vector<double>>& graph, vector<string>& labels, int& start, int& end);
\ No newline at end of file
+void readGraphFromFile(const string& filename, bool& fileLoaded, vector<vector<double>>& graph, vector<string>& labels, int& start, int& end);
+
+// readGraphFromFile wrapped into a shared graph, or nullptr when the file
+// cannot be read.
+GraphPtr loadGraph(const string& filename, int& start, int& end);
+
+// Edge-list file (extension .edges) for the sparse engine, read straight
+// into CSR so no n x n matrix is ever allocated: a first line
+// "vertices start end", then one "u v weight" line per undirected edge
+// with 0-based vertices. '#' starts a comment. Vertices are named like
+// generated graphs. Returns false, after printing why, on malformed input.
+bool isEdgeListFile(const string& filename);
+bool loadEdgeList(const string& filename, CsrGraph& graph, int& start, int& end);
@@ -0,0 +1,37 @@
+#include "Graph.h"
+
+using namespace std;
+
+VertexLabels::VertexLabels(vector<string> labels)
+    : names(move(labels)) {}
+
+string VertexLabels::operator[](int v) const {
+    if (v >= 0 && v < static_cast<int>(names.size())) {
+        return names[v];
+    }
+    if (v >= 0 && v < 26) {
+        return string(1, static_cast<char>('A' + v));
+    }
+    return "V" + to_string(v + 1);
+}
+
+string VertexLabels::join(const vector<int>& path, const string& separator) const {
+    string result;
+
+    for (size_t i = 0; i < path.size(); ++i) {
+        result += (*this)[path[i]];
+        if (i + 1 < path.size()) {
+            result += separator;
+        }
+    }
+
+    return result;
+}
+
+Graph::Graph(vector<vector<double>> matrix, VertexLabels labels)
+    : weights(move(matrix)), names(move(labels)) {}
+
+void Graph::setWeight(int u, int v, double weight) {
+    weights[u][v] = weight;
+    weights[v][u] = weight;
+}
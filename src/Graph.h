@@ -0,0 +1,56 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Vertex names. Names read from a graph file are stored; any other vertex
+// is named only when asked for (A to Z, then V27, V28, ...), so generated
+// graphs hold no label strings at all.
+class VertexLabels {
+public:
+    VertexLabels() = default;
+    explicit VertexLabels(std::vector<std::string> names);
+
+    std::string operator[](int v) const;
+
+    // Names of the vertices on path, separated by separator.
+    std::string join(const std::vector<int>& path, const std::string& separator) const;
+
+private:
+    std::vector<std::string> names;
+};
+
+// Dense weighted undirected graph, edge (u, v) present when weight(u, v) > 0.
+// Solvers hold it through GraphPtr and only read it, so a graph is in
+// memory once however many colonies, baselines or benchmark repeats run on
+// it. A holder that changes weights works on its own copy.
+class Graph {
+public:
+    explicit Graph(std::vector<std::vector<double>> weights, VertexLabels labels = VertexLabels());
+
+    int size() const {
+        return static_cast<int>(weights.size());
+    }
+
+    double weight(int u, int v) const {
+        return weights[u][v];
+    }
+
+    const std::vector<std::vector<double>>& matrix() const {
+        return weights;
+    }
+
+    const VertexLabels& labels() const {
+        return names;
+    }
+
+    // Sets both directions; a weight of 0 deletes the edge.
+    void setWeight(int u, int v, double weight);
+
+private:
+    std::vector<std::vector<double>> weights;
+    VertexLabels names;
+};
+
+using GraphPtr = std::shared_ptr<const Graph>;
@@ -0,0 +1,239 @@
+#include "MultiColony.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+MultiColony::MultiColony(GraphPtr g,
+                         int s,
+                         int e,
+                         const ACOParameters& params,
+                         MultiColonyOptions opts)
+    : graph(move(g)),
+      start(s),
+      end(e),
+      options(move(opts)),
+      logLevel(params.logLevel),
+      seed(resolveSeed(params.seed))
+{
+    options.colonies = max(1, options.colonies);
+    options.blendWeight = min(1.0, max(0.0, options.blendWeight));
+
+    control.timeBudget = params.timeBudget;
+    control.targetLength = params.targetLength;
+
+    for (int k = 0; k < options.colonies; ++k) {
+        ACOParameters island = params;
+        island.seed = seed + k;
+        island.numThreads = 1;
+        island.logLevel = LogLevel::Off;
+        island.timeBudget = 0.0;
+        island.targetLength = 0.0;
+
+        if (!options.alphas.empty()) {
+            island.alpha = options.alphas[k % options.alphas.size()];
+        }
+        if (!options.betas.empty()) {
+            island.beta = options.betas[k % options.betas.size()];
+        }
+
+        colonies.push_back(make_unique<AntColony>(graph, s, e, island));
+    }
+}
+
+MultiColony::~MultiColony() = default;
+
+// Snapshots first, so every colony blends with its neighbour's trails as
+// they were before this migration.
+void MultiColony::migrate() {
+    const int count = static_cast<int>(colonies.size());
+    if (count < 2) {
+        return;
+    }
+
+    vector<PheromoneMatrix> trails;
+    vector<vector<int>> paths;
+    vector<double> lengths;
+    trails.reserve(count);
+
+    for (const auto& colony : colonies) {
+        trails.push_back(colony->trails());
+        paths.push_back(colony->bestPath());
+        lengths.push_back(colony->bestLength());
+    }
+
+    for (int k = 0; k < count; ++k) {
+        const int from = (k + count - 1) % count;
+        colonies[k]->immigrate(paths[from], lengths[from]);
+        colonies[k]->blendTrails(trails[from], options.blendWeight);
+    }
+}
+
+MultiColonyResult MultiColony::run() {
+    MultiColonyResult result;
+    const int count = static_cast<int>(colonies.size());
+
+    for (auto& colony : colonies) {
+        colony->begin();
+    }
+
+    ThreadPool pool(ThreadPool::resolveThreadCount(options.threads, count, 1));
+    const int epoch = options.migrationInterval > 0 ? options.migrationInterval : numeric_limits<int>::max();
+    const auto runStart = chrono::steady_clock::now();
+
+    ACOStopReason stopReason = ACOStopReason::IterationLimit;
+    bool stoppedByControl = false;
+
+    // Raised by the first colony to meet a time budget or target length, so
+    // every colony stops within an iteration instead of finishing the epoch.
+    CancellationToken halt;
+
+    while (true) {
+        atomic<int> next{0};
+        pool.runOnAll([&](int) {
+            for (int k = next++; k < count; k = next++) {
+                AntColony& colony = *colonies[k];
+                for (int i = 0; i < epoch && !colony.exhausted() && !halt.cancelled(); ++i) {
+                    colony.iterate();
+
+                    const double best = colony.bestLength();
+                    const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - runStart).count();
+                    ACOStopReason reason;
+                    if (control.shouldStop(best < numeric_limits<double>::max(), best, elapsed, reason)) {
+                        halt.cancel();
+                    }
+                }
+            }
+        });
+
+        double best = numeric_limits<double>::max();
+        int iterations = 0;
+        for (const auto& colony : colonies) {
+            best = min(best, colony->bestLength());
+            iterations = max(iterations, colony->iterationsDone());
+        }
+
+        if (logLevel >= LogLevel::Progress) {
+            LogLine line;
+            line << "Iteration " << iterations;
+            if (best < numeric_limits<double>::max()) {
+                line << " - Best: " << best;
+            } else {
+                line << " - No path found yet";
+            }
+        }
+
+        const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - runStart).count();
+        if (control.shouldStop(best < numeric_limits<double>::max(), best, elapsed, stopReason)) {
+            stoppedByControl = true;
+            break;
+        }
+
+        if (options.migrationInterval > 0) {
+            migrate();
+            result.migrations++;
+        }
+
+        // A stagnated colony may be revived by a better immigrant, so this
+        // is checked after the migration.
+        const bool done = all_of(colonies.begin(), colonies.end(),
+                                 [](const unique_ptr<AntColony>& colony) { return colony->exhausted(); });
+        if (done) {
+            break;
+        }
+    }
+
+    if (!stoppedByControl) {
+        const bool allStagnated = all_of(colonies.begin(), colonies.end(),
+                                         [](const unique_ptr<AntColony>& colony) { return colony->stagnated(); });
+        stopReason = allStagnated ? ACOStopReason::Stagnation : ACOStopReason::IterationLimit;
+    }
+
+    size_t longest = 0;
+    for (int k = 0; k < count; ++k) {
+        result.colonies.push_back(colonies[k]->finish());
+        const ACOResult& colonyResult = result.colonies.back();
+        longest = max(longest, colonyResult.history.size());
+
+        if (colonyResult.pathFound &&
+            (result.bestColony < 0 || colonyResult.bestLength < result.colonies[result.bestColony].bestLength)) {
+            result.bestColony = k;
+        }
+    }
+
+    // A colony that stopped early keeps its final best in the merged curve.
+    result.mergedCurve.assign(longest, numeric_limits<double>::max());
+    for (const auto& colonyResult : result.colonies) {
+        for (size_t i = 0; i < longest && !colonyResult.history.empty(); ++i) {
+            const size_t last = min(i, colonyResult.history.size() - 1);
+            result.mergedCurve[i] = min(result.mergedCurve[i], colonyResult.history[last].bestLength);
+        }
+    }
+
+    result.best = result.bestColony >= 0 ? result.colonies[result.bestColony] : result.colonies.front();
+    result.best.iterations = static_cast<int>(longest);
+    result.best.seed = seed;
+    result.best.stopReason = stopReason;
+
+    if (logLevel >= LogLevel::Result) {
+        if (result.best.pathFound) {
+            LogLine() << "SUCCESS: Path found: " << result.best.bestPathLabels
+                      << " (length: " << result.best.bestLength
+                      << ", iterations: " << result.best.iterations << ")";
+        } else {
+            LogLine() << "FAIL: No path found from " << graph->labels()[start]
+                      << " to " << graph->labels()[end];
+        }
+    }
+
+    if (!options.convergenceFile.empty()) {
+        writeConvergence(result, options.convergenceFile);
+    }
+
+    return result;
+}
+
+bool MultiColony::writeConvergence(const MultiColonyResult& result, const string& filename) {
+    const fs::path parent = fs::path(filename).parent_path();
+    if (!parent.empty()) {
+        fs::create_directories(parent);
+    }
+
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Cannot open convergence file: " << filename << endl;
+        return false;
+    }
+
+    auto cell = [&file](double length) {
+        file << ",";
+        if (length < numeric_limits<double>::max()) {
+            file << length;
+        }
+    };
+
+    file << "Iteration";
+    for (size_t k = 0; k < result.colonies.size(); ++k) {
+        file << ",Colony" << k;
+    }
+    file << ",Merged\n";
+
+    for (size_t i = 0; i < result.mergedCurve.size(); ++i) {
+        file << i + 1;
+        for (const auto& colony : result.colonies) {
+            cell(i < colony.history.size() ? colony.history[i].bestLength : numeric_limits<double>::max());
+        }
+        cell(result.mergedCurve[i]);
+        file << "\n";
+    }
+
+    return true;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AntColony.h"
+
+struct MultiColonyOptions {
+    // Independent colonies (islands). Colony k runs with seed + k.
+    int colonies = 4;
+
+    // Iterations between migrations, 0 never migrates.
+    int migrationInterval = 10;
+
+    // Weight of the neighbour's trails when pheromone is blended, in [0, 1].
+    double blendWeight = 0.25;
+
+    // Per-colony alpha and beta, cycled when shorter than the number of
+    // colonies. Empty keeps the base parameters.
+    std::vector<double> alphas;
+    std::vector<double> betas;
+
+    // Threads running the colonies, 0 = hardware concurrency.
+    int threads = 0;
+
+    // Per-colony and merged convergence curves, empty disables them.
+    std::string convergenceFile = "results/aco_convergence.csv";
+};
+
+struct MultiColonyResult {
+    // Best path over all colonies; history is that of the best colony.
+    ACOResult best;
+    int bestColony = -1;
+
+    std::vector<ACOResult> colonies;
+
+    // Best length over all colonies after every iteration.
+    std::vector<double> mergedCurve;
+
+    int migrations = 0;
+};
+
+// Island model: several AntColony instances sharing one graph run in
+// parallel, one thread each, and only synchronise every migrationInterval
+// iterations. At a migration colony k receives the best path of colony
+// k - 1 on a ring and blends that colony's trails into its own. The time
+// budget and target length are checked after every colony iteration, so
+// they hold between migrations too.
+class MultiColony {
+public:
+    MultiColony(GraphPtr graph,
+                int start,
+                int end,
+                const ACOParameters& params = ACOParameters(),
+                MultiColonyOptions options = MultiColonyOptions());
+
+    ~MultiColony();
+
+    MultiColonyResult run();
+
+    // Writes Iteration, one column per colony and Merged; a cell is empty
+    // before the colony's first path and after it stopped.
+    static bool writeConvergence(const MultiColonyResult& result, const std::string& filename);
+
+private:
+    std::vector<std::unique_ptr<AntColony>> colonies;
+    GraphPtr graph;
+    int start;
+    int end;
+
+    MultiColonyOptions options;
+    ACORunControl control;
+    LogLevel logLevel;
+    std::uint64_t seed;
+
+    void migrate();
+};
@@ -0,0 +1,348 @@
+#include "ParameterFile.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cctype>
+
+using namespace std;
+
+namespace {
+    string trim(const string& s) {
+        size_t start = 0;
+        while (start < s.size() && isspace(static_cast<unsigned char>(s[start]))) {
+            start++;
+        }
+
+        size_t end = s.size();
+        while (end > start && isspace(static_cast<unsigned char>(s[end - 1]))) {
+            end--;
+        }
+
+        return s.substr(start, end - start);
+    }
+
+    bool parseBool(const string& s, bool& value) {
+        if (s == "1" || s == "true" || s == "yes" || s == "on") {
+            value = true;
+            return true;
+        }
+        if (s == "0" || s == "false" || s == "no" || s == "off") {
+            value = false;
+            return true;
+        }
+        return false;
+    }
+
+    // Splits "key = value" after stripping comments. Returns false for blank
+    // lines and sets malformed when there is no '='.
+    bool splitLine(const string& rawLine, string& key, string& value, bool& malformed) {
+        string line = rawLine;
+        const size_t comment = line.find('#');
+        if (comment != string::npos) {
+            line = line.substr(0, comment);
+        }
+
+        line = trim(line);
+        malformed = false;
+        if (line.empty()) {
+            return false;
+        }
+
+        const size_t eq = line.find('=');
+        if (eq == string::npos) {
+            malformed = true;
+            return false;
+        }
+
+        key = trim(line.substr(0, eq));
+        value = trim(line.substr(eq + 1));
+        return true;
+    }
+}
+
+bool parseDouble(const string& s, double& value) {
+    try {
+        size_t pos = 0;
+        value = stod(s, &pos);
+        return pos == s.size();
+    } catch (...) {
+        return false;
+    }
+}
+
+bool parseInt(const string& s, int& value) {
+    try {
+        size_t pos = 0;
+        value = stoi(s, &pos);
+        return pos == s.size() && value >= 0;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool setParameter(ACOParameters& params, const string& key, const string& value) {
+    double d = 0.0;
+    int i = 0;
+
+    if (key == "alpha") {
+        if (!parseDouble(value, d) || d < 0.0) return false;
+        params.alpha = d;
+    } else if (key == "beta") {
+        if (!parseDouble(value, d) || d < 0.0) return false;
+        params.beta = d;
+    } else if (key == "evaporation") {
+        if (!parseDouble(value, d) || d <= 0.0 || d > 1.0) return false;
+        params.evaporation = d;
+    } else if (key == "q") {
+        if (!parseDouble(value, d) || d <= 0.0) return false;
+        params.Q = d;
+    } else if (key == "ants") {
+        if (!parseInt(value, i)) return false;
+        params.numAnts = i;
+    } else if (key == "iterations") {
+        if (!parseInt(value, i)) return false;
+        params.maxIterations = i;
+    } else if (key == "stagnation") {
+        if (!parseInt(value, i)) return false;
+        params.stagnationLimit = i;
+    } else if (key == "candidates") {
+        if (!parseInt(value, i)) return false;
+        params.candidateListSize = i;
+    } else if (key == "threads") {
+        if (!parseInt(value, i)) return false;
+        params.numThreads = i;
+    } else if (key == "ant_batch") {
+        if (!parseInt(value, i) || i < 0) return false;
+        params.antBatch = i;
+    } else if (key == "lazy_evaporation") {
+        return parseBool(value, params.lazyEvaporation);
+    } else if (key == "prune_dead_ends") {
+        return parseBool(value, params.pruneDeadEnds);
+    } else if (key == "repair_ants") {
+        return parseBool(value, params.repairAnts);
+    } else if (key == "branch_and_bound") {
+        return parseBool(value, params.branchAndBound);
+    } else if (key == "strategy") {
+        return parseStrategy(value, params.strategy);
+    } else if (key == "sampling") {
+        return parseSampling(value, params.sampling);
+    } else if (key == "heuristic") {
+        return parseHeuristic(value, params.heuristic);
+    } else if (key == "engine") {
+        if (value == "dense") {
+            params.engine = ACOEngine::Dense;
+        } else if (value == "sparse") {
+            params.engine = ACOEngine::Sparse;
+        } else {
+            return false;
+        }
+    } else if (key == "acs_q0") {
+        if (!parseDouble(value, d) || d < 0.0 || d > 1.0) return false;
+        params.acsQ0 = d;
+    } else if (key == "acs_local_evaporation") {
+        if (!parseDouble(value, d) || d < 0.0 || d > 1.0) return false;
+        params.acsLocalEvaporation = d;
+    } else if (key == "log_level") {
+        return parseLogLevel(value, params.logLevel);
+    } else if (key == "time_budget") {
+        if (!parseDouble(value, d) || d < 0.0) return false;
+        params.timeBudget = d;
+    } else if (key == "target_length") {
+        if (!parseDouble(value, d) || d < 0.0) return false;
+        params.targetLength = d;
+    } else if (key == "seed") {
+        try {
+            size_t pos = 0;
+            params.seed = stoull(value, &pos);
+            return pos == value.size() && value.front() != '-';
+        } catch (...) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+bool loadParameterFile(const string& filename, ACOParameters& params) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Cannot open parameter file: " << filename << endl;
+        return false;
+    }
+
+    string line;
+    int lineNumber = 0;
+    bool ok = true;
+
+    while (getline(file, line)) {
+        lineNumber++;
+
+        string key;
+        string value;
+        bool malformed = false;
+        if (!splitLine(line, key, value, malformed)) {
+            if (malformed) {
+                cerr << filename << ":" << lineNumber << ": expected key = value" << endl;
+                ok = false;
+            }
+            continue;
+        }
+
+        if (!setParameter(params, key, value)) {
+            cerr << filename << ":" << lineNumber << ": invalid parameter " << key << " = " << value << endl;
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+bool saveParameterFile(const string& filename, const ACOParameters& params) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Cannot open parameter file for writing: " << filename << endl;
+        return false;
+    }
+
+    file << "# ACO parameters (0 = derived from the graph size)\n";
+    file << "alpha = " << params.alpha << "\n";
+    file << "beta = " << params.beta << "\n";
+    file << "evaporation = " << params.evaporation << "\n";
+    file << "q = " << params.Q << "\n";
+    file << "ants = " << params.numAnts << "\n";
+    file << "iterations = " << params.maxIterations << "\n";
+    file << "stagnation = " << params.stagnationLimit << "\n";
+    file << "strategy = " << strategyName(params.strategy) << "\n";
+    file << "engine = " << (params.engine == ACOEngine::Sparse ? "sparse" : "dense") << "\n";
+    file << "candidates = " << params.candidateListSize << "\n";
+    file << "sampling = " << samplingName(params.sampling) << "\n";
+    file << "ant_batch = " << params.antBatch << "\n";
+    file << "heuristic = " << heuristicName(params.heuristic) << "\n";
+    file << "lazy_evaporation = " << (params.lazyEvaporation ? "true" : "false") << "\n";
+    file << "prune_dead_ends = " << (params.pruneDeadEnds ? "true" : "false") << "\n";
+    file << "repair_ants = " << (params.repairAnts ? "true" : "false") << "\n";
+    file << "branch_and_bound = " << (params.branchAndBound ? "true" : "false") << "\n";
+    file << "acs_q0 = " << params.acsQ0 << "\n";
+    file << "acs_local_evaporation = " << params.acsLocalEvaporation << "\n";
+    if (params.timeBudget > 0.0) {
+        file << "time_budget = " << params.timeBudget << "\n";
+    }
+    if (params.targetLength > 0.0) {
+        file << "target_length = " << params.targetLength << "\n";
+    }
+    if (params.seed != 0) {
+        file << "seed = " << params.seed << "\n";
+    }
+
+    return true;
+}
+
+string describeParameters(const ACOParameters& params) {
+    // Every key, so configurations that differ in any of them never share
+    // a description.
+    ostringstream out;
+    out << "alpha=" << params.alpha
+        << " beta=" << params.beta
+        << " evaporation=" << params.evaporation
+        << " q=" << params.Q
+        << " ants=" << params.numAnts
+        << " iterations=" << params.maxIterations
+        << " stagnation=" << params.stagnationLimit
+        << " strategy=" << strategyName(params.strategy)
+        << " engine=" << (params.engine == ACOEngine::Sparse ? "sparse" : "dense")
+        << " candidates=" << params.candidateListSize
+        << " threads=" << params.numThreads
+        << " ant_batch=" << params.antBatch
+        << " sampling=" << samplingName(params.sampling)
+        << " heuristic=" << heuristicName(params.heuristic)
+        << " lazy_evaporation=" << (params.lazyEvaporation ? "true" : "false")
+        << " prune_dead_ends=" << (params.pruneDeadEnds ? "true" : "false")
+        << " repair_ants=" << (params.repairAnts ? "true" : "false")
+        << " branch_and_bound=" << (params.branchAndBound ? "true" : "false")
+        << " acs_q0=" << params.acsQ0
+        << " acs_local_evaporation=" << params.acsLocalEvaporation
+        << " time_budget=" << params.timeBudget
+        << " target_length=" << params.targetLength
+        << " seed=" << params.seed
+        << " log_level=" << logLevelName(params.logLevel);
+
+    return out.str();
+}
+
+bool loadParameterGrid(const string& filename, vector<ParameterAxis>& axes) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Cannot open sweep grid file: " << filename << endl;
+        return false;
+    }
+
+    axes.clear();
+
+    string line;
+    int lineNumber = 0;
+    bool ok = true;
+    ACOParameters probe;
+
+    while (getline(file, line)) {
+        lineNumber++;
+
+        string key;
+        string list;
+        bool malformed = false;
+        if (!splitLine(line, key, list, malformed)) {
+            if (malformed) {
+                cerr << filename << ":" << lineNumber << ": expected key = v1, v2, ..." << endl;
+                ok = false;
+            }
+            continue;
+        }
+
+        ParameterAxis axis{key, {}};
+        stringstream ss(list);
+        string value;
+        while (getline(ss, value, ',')) {
+            value = trim(value);
+            if (value.empty()) {
+                continue;
+            }
+
+            if (!setParameter(probe, key, value)) {
+                cerr << filename << ":" << lineNumber << ": invalid parameter " << key << " = " << value << endl;
+                ok = false;
+                continue;
+            }
+
+            axis.second.push_back(value);
+        }
+
+        if (!axis.second.empty()) {
+            axes.push_back(axis);
+        }
+    }
+
+    return ok;
+}
+
+vector<ACOParameters> expandParameterGrid(const ACOParameters& base, const vector<ParameterAxis>& axes) {
+    vector<ACOParameters> configurations = {base};
+
+    for (const auto& [key, values] : axes) {
+        vector<ACOParameters> expanded;
+        expanded.reserve(configurations.size() * values.size());
+
+        for (const auto& params : configurations) {
+            for (const auto& value : values) {
+                ACOParameters next = params;
+                setParameter(next, key, value);
+                expanded.push_back(next);
+            }
+        }
+
+        configurations.swap(expanded);
+    }
+
+    return configurations;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AntColony.h"
+
+// Checked numbers for parameter values and command-line options: the whole
+// string must parse, and integers must be non-negative.
+bool parseDouble(const std::string& s, double& value);
+bool parseInt(const std::string& s, int& value);
+
+// Plain text ACO configuration: one "key = value" pair per line, '#'
+// starts a comment. Keys: alpha, beta, evaporation, q, ants, iterations,
+// stagnation, strategy, engine, candidates, threads, ant_batch,
+// lazy_evaporation, acs_q0, acs_local_evaporation, sampling, heuristic,
+// prune_dead_ends, repair_ants, branch_and_bound, log_level, time_budget,
+// target_length, seed.
+bool setParameter(ACOParameters& params, const std::string& key, const std::string& value);
+bool loadParameterFile(const std::string& filename, ACOParameters& params);
+bool saveParameterFile(const std::string& filename, const ACOParameters& params);
+
+// Single-line "key=value ..." summary for logs and sweep reports.
+std::string describeParameters(const ACOParameters& params);
+
+// Sweep grid: same format as a parameter file, but every key lists the
+// comma-separated values to try.
+using ParameterAxis = std::pair<std::string, std::vector<std::string>>;
+
+bool loadParameterGrid(const std::string& filename, std::vector<ParameterAxis>& axes);
+
+// Cartesian product of the axes applied on top of base, last axis varying
+// fastest.
+std::vector<ACOParameters> expandParameterGrid(const ACOParameters& base, const std::vector<ParameterAxis>& axes);
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "AlignedAllocator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Build with -DACO_PHEROMONE_FLOAT to store trails in single precision.
+#ifdef ACO_PHEROMONE_FLOAT
+using PheromoneValue = float;
+#else
+using PheromoneValue = double;
+#endif
+
+// Symmetric pheromone trails of an undirected graph, stored as a packed
+// upper triangle (diagonal excluded) in one aligned buffer.
+//
+// In lazy mode evaporation is not applied to the buffer. Every entry keeps
+// the epoch of its last update and its value is decayed on read as
+// tau * (1 - rho)^(epoch - stamp), so an evaporation step costs O(1).
+class PheromoneMatrix {
+public:
+    PheromoneMatrix() : n(0), lazy(false), epoch(0), lazyKeep(1.0), lazyLower(0.0), decayTail(0.0) {}
+
+    PheromoneMatrix(int vertices, double initial)
+        : n(vertices),
+          values(static_cast<std::size_t>(vertices) * (vertices > 0 ? vertices - 1 : 0) / 2,
+                 static_cast<PheromoneValue>(initial)),
+          lazy(false),
+          epoch(0),
+          lazyKeep(1.0),
+          lazyLower(0.0),
+          decayTail(0.0) {}
+
+    int size() const {
+        return n;
+    }
+
+    bool isLazy() const {
+        return lazy;
+    }
+
+    // Switches to lazy evaporation with a fixed rate and the given clamp
+    // bounds. The upper bound only sizes the power table: past the epoch
+    // where upper * (1 - rho)^k drops below lower every trail reads as lower.
+    void setLazyEvaporation(double evaporation, double lower, double upper) {
+        lazy = true;
+        lazyKeep = 1.0 - evaporation;
+        stamps.assign(values.size(), epoch);
+        setLazyBounds(lower, upper);
+    }
+
+    // Moves the clamp bounds of a lazy matrix without touching the stamps.
+    void setLazyBounds(double lower, double upper) {
+        lazyLower = lower;
+        decayTable.assign(1, 1.0);
+
+        if (lazyKeep >= 1.0) {
+            decayTail = 1.0;
+            return;
+        }
+
+        decayTail = 0.0;
+        if (lazyKeep <= 0.0 || upper <= lower) {
+            return;
+        }
+
+        const double steps = std::ceil(std::log(lower / upper) / std::log(lazyKeep));
+        const std::size_t tableSize = static_cast<std::size_t>(std::max(1.0, steps)) + 1;
+
+        decayTable.resize(tableSize);
+        for (std::size_t k = 1; k < tableSize; ++k) {
+            decayTable[k] = decayTable[k - 1] * lazyKeep;
+        }
+    }
+
+    double get(int u, int v) const {
+        const std::size_t i = index(u, v);
+        return lazy ? decayed(i) : values[i];
+    }
+
+    // Adds a deposit and caps the trail at upper.
+    void add(int u, int v, double amount, double upper) {
+        const std::size_t i = index(u, v);
+        double tau = values[i];
+
+        if (lazy) {
+            tau = decayed(i);
+            stamps[i] = epoch;
+        }
+
+        values[i] = static_cast<PheromoneValue>(std::min(upper, tau + amount));
+    }
+
+    void set(int u, int v, double value) {
+        const std::size_t i = index(u, v);
+        if (lazy) {
+            stamps[i] = epoch;
+        }
+        values[i] = static_cast<PheromoneValue>(value);
+    }
+
+    void fill(double value) {
+        std::fill(values.begin(), values.end(), static_cast<PheromoneValue>(value));
+        std::fill(stamps.begin(), stamps.end(), epoch);
+    }
+
+    // Evaporation fused with the lower clamp. Deposits only raise trails,
+    // so the upper clamp is applied by add() on the edges they touch.
+    // In lazy mode this only advances the epoch.
+    void evaporateAndClamp(double evaporation, double lower) {
+        if (lazy) {
+            epoch++;
+            return;
+        }
+
+        const PheromoneValue keep = static_cast<PheromoneValue>(1.0 - evaporation);
+        const PheromoneValue floor = static_cast<PheromoneValue>(lower);
+        PheromoneValue* data = values.data();
+        const std::size_t count = values.size();
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const PheromoneValue tau = data[i] * keep;
+            data[i] = tau < floor ? floor : tau;
+        }
+    }
+
+private:
+    int n;
+    std::vector<PheromoneValue, AlignedAllocator<PheromoneValue>> values;
+
+    bool lazy;
+    std::uint32_t epoch;
+    double lazyKeep;
+    double lazyLower;
+    double decayTail;
+    std::vector<std::uint32_t> stamps;
+    std::vector<double> decayTable;
+
+    double decayed(std::size_t i) const {
+        const std::size_t age = epoch - stamps[i];
+        const double factor = age < decayTable.size() ? decayTable[age] : decayTail;
+        return std::max(lazyLower, values[i] * factor);
+    }
+
+    std::size_t index(int u, int v) const {
+        if (u > v) {
+            std::swap(u, v);
+        }
+        const std::size_t row = static_cast<std::size_t>(u);
+        return row * (2 * static_cast<std::size_t>(n) - row - 1) / 2 + static_cast<std::size_t>(v - u - 1);
+    }
+};
@@ -0,0 +1,117 @@
+#include "PheromoneStore.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace {
+    const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+    const uint64_t FNV_PRIME = 1099511628211ull;
+
+    uint64_t fnvMix(uint64_t hash, uint64_t value) {
+        for (int byte = 0; byte < 8; ++byte) {
+            hash ^= (value >> (8 * byte)) & 0xff;
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+}
+
+PheromoneStore::PheromoneStore(size_t capacity, double decayFactor)
+    : capacityBytes(capacity),
+      decay(min(1.0, max(0.0, decayFactor))),
+      usedBytes(0) {}
+
+uint64_t PheromoneStore::fingerprint(const vector<vector<double>>& graph) {
+    const size_t n = graph.size();
+    uint64_t hash = fnvMix(FNV_OFFSET_BASIS, n);
+
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+            uint64_t bits = 0;
+            const double weight = graph[i][j] > 0.0 ? graph[i][j] : 0.0;
+            memcpy(&bits, &weight, sizeof(bits));
+            hash = fnvMix(hash, bits);
+        }
+    }
+
+    return hash;
+}
+
+vector<double> PheromoneStore::warmStart(uint64_t key) {
+    lock_guard<std::mutex> lock(mutex);
+
+    const auto found = index.find(key);
+    if (found == index.end()) {
+        return {};
+    }
+
+    entries.splice(entries.begin(), entries, found->second);
+    const vector<double>& trails = found->second->trails;
+
+    const double largest = trails.empty() ? 0.0 : *max_element(trails.begin(), trails.end());
+    if (largest <= 0.0) {
+        return {};
+    }
+
+    vector<double> profile(trails.size());
+    for (size_t i = 0; i < trails.size(); ++i) {
+        profile[i] = (1.0 - decay) + decay * trails[i] / largest;
+    }
+
+    return profile;
+}
+
+void PheromoneStore::store(uint64_t key, const PheromoneMatrix& trails) {
+    const int n = trails.size();
+
+    Entry entry{key, {}};
+    entry.trails.reserve(static_cast<size_t>(n) * (n > 0 ? n - 1 : 0) / 2);
+    for (int u = 0; u < n; ++u) {
+        for (int v = u + 1; v < n; ++v) {
+            entry.trails.push_back(trails.get(u, v));
+        }
+    }
+
+    if (bytesOf(entry) > capacityBytes) {
+        return;
+    }
+
+    lock_guard<std::mutex> lock(mutex);
+
+    const auto found = index.find(key);
+    if (found != index.end()) {
+        usedBytes -= bytesOf(*found->second);
+        entries.erase(found->second);
+        index.erase(found);
+    }
+
+    usedBytes += bytesOf(entry);
+    entries.push_front(move(entry));
+    index[key] = entries.begin();
+
+    evict();
+}
+
+size_t PheromoneStore::bytesUsed() const {
+    lock_guard<std::mutex> lock(mutex);
+    return usedBytes;
+}
+
+size_t PheromoneStore::size() const {
+    lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+size_t PheromoneStore::bytesOf(const Entry& entry) {
+    return entry.trails.size() * sizeof(double);
+}
+
+void PheromoneStore::evict() {
+    while (usedBytes > capacityBytes && !entries.empty()) {
+        usedBytes -= bytesOf(entries.back());
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "PheromoneMatrix.h"
+
+// Trails of finished runs kept per graph, so later queries on the same
+// graph (any start and end) can start from them instead of uniform
+// trails. Graphs are identified by an FNV-1a fingerprint of their weights.
+// The least recently used graphs are evicted once the stored trails exceed
+// the memory budget. All methods are thread-safe.
+class PheromoneStore {
+public:
+    static const std::size_t DEFAULT_CAPACITY_BYTES = 64u << 20;
+
+    // decay in [0, 1] is how much of the stored trail survives into a warm
+    // start: 0 gives uniform trails, 1 the stored profile unchanged.
+    explicit PheromoneStore(std::size_t capacityBytes = DEFAULT_CAPACITY_BYTES, double decay = 0.5);
+
+    static std::uint64_t fingerprint(const std::vector<std::vector<double>>& graph);
+
+    // Packed upper-triangle profile for the graph, renormalised so its
+    // largest entry is 1 and decayed towards 1: every value lies in
+    // [1 - decay, 1] and multiplies the colony's initial trail level.
+    // Empty when the graph is not stored.
+    std::vector<double> warmStart(std::uint64_t key);
+
+    // Stores (or replaces) the trails of a run on the graph.
+    void store(std::uint64_t key, const PheromoneMatrix& trails);
+
+    std::size_t bytesUsed() const;
+    std::size_t size() const;
+
+private:
+    struct Entry {
+        std::uint64_t key;
+        std::vector<double> trails;
+    };
+
+    std::size_t capacityBytes;
+    double decay;
+    std::size_t usedBytes;
+
+    // Most recently used first.
+    std::list<Entry> entries;
+    std::unordered_map<std::uint64_t, std::list<Entry>::iterator> index;
+    mutable std::mutex mutex;
+
+    static std::size_t bytesOf(const Entry& entry);
+    void evict();
+};
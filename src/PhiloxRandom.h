@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random
+// Numbers: As Easy as 1, 2, 3"). The output block is a pure function of a
+// 64-bit key and a 128-bit counter, so any stream can be reproduced from
+// its coordinates without sharing state between threads.
+class PhiloxRandom {
+public:
+    using Block = std::array<std::uint32_t, 4>;
+
+    static Block generate(Block counter, std::uint64_t key) {
+        std::uint32_t k0 = static_cast<std::uint32_t>(key);
+        std::uint32_t k1 = static_cast<std::uint32_t>(key >> 32);
+
+        for (int round = 0; round < 10; ++round) {
+            const std::uint64_t p0 = static_cast<std::uint64_t>(M0) * counter[0];
+            const std::uint64_t p1 = static_cast<std::uint64_t>(M1) * counter[2];
+
+            counter = {
+                static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ k0,
+                static_cast<std::uint32_t>(p1),
+                static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ k1,
+                static_cast<std::uint32_t>(p0)
+            };
+
+            k0 += W0;
+            k1 += W1;
+        }
+
+        return counter;
+    }
+
+private:
+    static constexpr std::uint32_t M0 = 0xD2511F53u;
+    static constexpr std::uint32_t M1 = 0xCD9E8D57u;
+    static constexpr std::uint32_t W0 = 0x9E3779B9u;
+    static constexpr std::uint32_t W1 = 0xBB67AE85u;
+};
+
+// Uniform doubles for one ant in one iteration. The counter is
+// (iteration, ant, step, block): every construction step starts a fresh
+// sub-stream, so the draws an ant sees depend only on where it is, not on
+// which thread builds it or how many draws earlier steps consumed.
+class PhiloxStream {
+public:
+    PhiloxStream() = default;
+
+    PhiloxStream(std::uint64_t seed, std::uint32_t iteration, std::uint32_t ant)
+        : key(seed),
+          counter{iteration, ant, 0, 0} {}
+
+    void setStep(std::uint32_t step) {
+        counter[2] = step;
+        counter[3] = 0;
+        used = 4;
+    }
+
+    // 53-bit double in [0, 1) built from two 32-bit words.
+    double uniform() {
+        if (used == 4) {
+            block = PhiloxRandom::generate(counter, key);
+            counter[3]++;
+            used = 0;
+        }
+
+        const std::uint64_t high = block[used] >> 5;
+        const std::uint64_t low = block[used + 1] >> 6;
+        used += 2;
+
+        return (high * 67108864.0 + low) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+    std::uint64_t key = 0;
+    PhiloxRandom::Block counter{};
+    PhiloxRandom::Block block{};
+    int used = 4;
+};
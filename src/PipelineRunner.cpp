@@ -7,6 +7,8 @@
 #include "ResultAnalyzer.h"
 #include "GenerateTestSuite.h"
 #include "BellmanFord.h"
+#include "ParameterFile.h"
+#include "ThreadPool.h"
 
 #include <iostream>
 #include <filesystem>
@@ -14,6 +16,9 @@
 #include <chrono>
 #include <iomanip>
 #include <sstream>
+#include <atomic>
+#include <mutex>
+#include <tuple>
 
 using namespace std;
 namespace fs = std::filesystem;
@@ -73,8 +78,9 @@ namespace {
     }
 }
 
-PipelineRunner::PipelineRunner(std::string testDirectory)
-    : testDirectory(std::move(testDirectory)) {}
+PipelineRunner::PipelineRunner(std::string testDirectory, ACOParameters acoParameters)
+    : testDirectory(std::move(testDirectory)),
+      acoParameters(acoParameters) {}
 
 const string& PipelineRunner::getTestDirectory() const {
     return testDirectory;
@@ -140,6 +146,10 @@ void PipelineRunner::writeExperimentMetadata(const string& mode) const {
     file << "  \"detected_test_count\": " << suiteCount << ",\n";
     file << "  \"expected_test_count\": 100,\n";
     file << "  \"results_directory\": \"results\",\n";
+    // 0 means every colony drew its own seed; the per-test seeds are in
+    // the Seed column of the ACO results.
+    file << "  \"aco_seed\": " << acoParameters.seed << ",\n";
+    file << "  \"aco_parameters\": \"" << escapeJson(describeParameters(acoParameters)) << "\",\n";
     file << "  \"expected_result_files\": [\n";
     file << "    \"results/aco_results.csv\",\n";
     file << "    \"results/dijkstra_results.csv\",\n";
@@ -168,7 +178,7 @@ void PipelineRunner::generateTests() const {
 
 void PipelineRunner::runACO() const {
     cout << "=== ACO Algorithm Test Suite ===" << endl;
-    TestRunner runner;
+    TestRunner runner(acoParameters);
     runner.runTestSuite(testDirectory);
     cout << "=== Testing complete ===" << endl;
 }
@@ -201,6 +211,122 @@ void PipelineRunner::runAStar() const {
     cout << "=== A* Testing complete ===" << endl;
 }
 
+void PipelineRunner::compareAcoStrategies() const {
+    fs::create_directories("results");
+
+    if (!fs::exists("results/dijkstra_results.csv")) {
+        runDijkstra();
+        cout << endl;
+    }
+
+    const vector<ACOStrategy> strategies = {ACOStrategy::Elitist, ACOStrategy::MaxMin, ACOStrategy::ColonySystem};
+    vector<pair<string, string>> strategyFiles;
+
+    for (ACOStrategy strategy : strategies) {
+        const string name = strategyName(strategy);
+        const string file = "aco_" + name + "_results.csv";
+
+        cout << "=== ACO Strategy: " << name << " ===" << endl;
+
+        ACOParameters params = acoParameters;
+        params.strategy = strategy;
+
+        TestRunner runner(params);
+        runner.setOutputFile("results/" + file);
+        runner.runTestSuite(testDirectory);
+        cout << endl;
+
+        strategyFiles.push_back({name, file});
+    }
+
+    ResultsAnalyzer analyzer("results");
+    analyzer.compareAcoStrategies(strategyFiles, "dijkstra_results.csv");
+}
+
+void PipelineRunner::runParameterSweep(const vector<ACOParameters>& configurations, int threads) const {
+    fs::create_directories("results/sweep");
+
+    if (!fs::exists("results/dijkstra_results.csv")) {
+        runDijkstra();
+        cout << endl;
+    }
+
+    const int count = static_cast<int>(configurations.size());
+    const int width = static_cast<int>(to_string(max(0, count - 1)).size());
+
+    vector<tuple<string, string, string>> configFiles;
+    for (int i = 0; i < count; ++i) {
+        ostringstream name;
+        name << "cfg_" << setw(width) << setfill('0') << i;
+        configFiles.emplace_back(name.str(), "sweep/aco_" + name.str() + ".csv", describeParameters(configurations[i]));
+    }
+
+    ofstream index("results/sweep/sweep_configurations.csv");
+    index << "Config,Parameters\n";
+    for (const auto& [name, file, description] : configFiles) {
+        index << name << ",\"" << description << "\"\n";
+    }
+    index.close();
+
+    // Configurations are the unit of parallelism: each colony runs on a
+    // single thread, so per-test times stay comparable across the grid.
+    ThreadPool pool(ThreadPool::resolveThreadCount(threads, count, 1));
+    cout << "=== ACO Parameter Sweep: " << count << " configurations on "
+         << pool.size() << " threads ===" << endl;
+
+    atomic<int> next{0};
+    int finished = 0;
+    mutex progressMutex;
+
+    pool.runOnAll([&](int) {
+        for (int i = next++; i < count; i = next++) {
+            ACOParameters params = configurations[i];
+            params.numThreads = 1;
+            params.logLevel = LogLevel::Off;
+
+            TestRunner runner(params);
+            runner.setOutputFile("results/" + get<1>(configFiles[i]));
+            runner.runTestSuite(testDirectory);
+
+            lock_guard<mutex> lock(progressMutex);
+            finished++;
+            cout << "[" << finished << "/" << count << "] " << get<0>(configFiles[i])
+                 << ": " << get<2>(configFiles[i]) << endl;
+        }
+    });
+
+    cout << endl;
+    ResultsAnalyzer analyzer("results");
+    analyzer.rankConfigurations(configFiles, "dijkstra_results.csv", "sweep/sweep_ranking.csv");
+}
+
+bool PipelineRunner::runAutotune(const vector<ACOParameters>& candidates,
+                                 const AutoTuneOptions& options,
+                                 const string& outputFile) const {
+    AutoTuner tuner(testDirectory, options);
+    const AutoTuneResult result = tuner.race(candidates);
+
+    if (result.bestIndex < 0) {
+        return false;
+    }
+
+    cout << "\nRace finished after " << result.instancesUsed << " graphs and "
+         << result.evaluations << " runs, " << result.survivors.size() << " configurations left." << endl;
+    cout << "Best: " << describeParameters(result.best) << endl;
+
+    const fs::path outputPath(outputFile);
+    if (outputPath.has_parent_path()) {
+        fs::create_directories(outputPath.parent_path());
+    }
+
+    if (!saveParameterFile(outputFile, result.best)) {
+        return false;
+    }
+
+    cout << "Tuned parameters saved to: " << outputFile << endl;
+    return true;
+}
+
 void PipelineRunner::runAllAlgorithms() const {
     fs::create_directories("results");
 
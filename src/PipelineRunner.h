@@ -1,10 +1,15 @@
 #pragma once
 
 #include <string>
+#include <vector>
+
+#include "AntColony.h"
+#include "AutoTuner.h"
 
 class PipelineRunner {
 public:
-    explicit PipelineRunner(std::string testDirectory = "data/test_cases");
+    explicit PipelineRunner(std::string testDirectory = "data/test_cases",
+                            ACOParameters acoParameters = ACOParameters());
 
     bool ensureTestSuiteExists() const;
     void generateTests() const;
@@ -15,6 +20,19 @@ public:
     void runBellmanFord() const;
     void runAStar() const;
 
+    void compareAcoStrategies() const;
+
+    // Runs every configuration over the test suite, several at a time,
+    // writing results/sweep/aco_<config>.csv for each and a ranking by
+    // time-to-quality. threads = 0 uses all hardware threads.
+    void runParameterSweep(const std::vector<ACOParameters>& configurations, int threads) const;
+
+    // Races the candidates on a sample of the suite and writes the winner
+    // as a parameter file. Returns false when nothing could be raced.
+    bool runAutotune(const std::vector<ACOParameters>& candidates,
+                     const AutoTuneOptions& options,
+                     const std::string& outputFile) const;
+
     void runAllAlgorithms() const;
     void analyzeResults() const;
     void fullPipeline(bool generateIfMissing = true) const;
@@ -23,6 +41,7 @@ public:
 
 private:
     std::string testDirectory;
+    ACOParameters acoParameters;
 
     void clearResultsDirectory() const;
     void writeExperimentMetadata(const std::string& mode) const;
@@ -12,6 +12,7 @@
 #include <cmath>
 #include <filesystem>
 #include <limits>
+#include <tuple>
 
 using namespace std;
 
@@ -24,6 +25,12 @@ struct TestResults {
     bool foundPath;
     int iterations;
     string bestPathSequence;
+
+    string strategy;
+    int bestIteration = 0;
+    double timeToBest = 0.0;
+    unsigned long long seed = 0;
+    double successRate = 0.0;
 };
 
 struct NumericStats {
@@ -159,6 +166,239 @@ public:
         saveRankingsCSV(joinPath(resultsDir, "algorithm_rankings.csv"));
     }
 
+    // Compares ACO strategy runs (strategy name -> results file) with the
+    // Dijkstra optimum: how often each strategy reaches it and how long it
+    // takes to get there, overall, per size category and on the large_* suite.
+    void compareAcoStrategies(const vector<pair<string, string>>& strategyFiles,
+                              const string& dijkstraFile) {
+        const auto dijkstraMap = buildResultMap(loadCSV(joinPath(resultsDir, dijkstraFile)));
+        if (dijkstraMap.empty()) {
+            cerr << "Error: Dijkstra results are required to compare ACO strategies." << endl;
+            return;
+        }
+
+        vector<pair<string, vector<TestResults>>> strategies;
+        for (const auto& [name, file] : strategyFiles) {
+            strategies.push_back({name, loadCSV(joinPath(resultsDir, file))});
+        }
+
+        vector<pair<string, string>> scopes = {
+            {"Overall", "All"},
+            {"Size", "Small(5-15)"},
+            {"Size", "Medium(16-50)"},
+            {"Size", "Large(51-100)"},
+            {"Size", "Huge(101+)"},
+            {"Suite", "large_*"}
+        };
+
+        auto inScope = [](const pair<string, string>& scope, const TestResults& r) -> bool {
+            if (scope.first == "Overall") return true;
+            if (scope.first == "Size") return detectSizeCategory(r) == scope.second;
+            if (scope.first == "Suite") return r.testName.find("_large_") != string::npos;
+            return false;
+        };
+
+        const string filename = joinPath(resultsDir, "aco_strategy_comparison.csv");
+        ofstream file(filename);
+        if (!file.is_open()) {
+            cerr << "Cannot open file for writing: " << filename << endl;
+            return;
+        }
+
+        file << "ScopeType,ScopeValue,Strategy,Tests,OptimalityRate,AvgTime,AvgTimeToBest,"
+             << "AvgTimeToOptimal,AvgBestIteration,AvgIterations\n";
+
+        cout << "ACO STRATEGY COMPARISON" << endl;
+        cout << "===============================================================" << endl;
+        cout << setw(16) << "Scope"
+             << setw(10) << "Strategy"
+             << setw(8) << "Tests"
+             << setw(12) << "Optimal%"
+             << setw(12) << "AvgTime"
+             << setw(14) << "TimeToOpt"
+             << setw(12) << "BestIter" << endl;
+        cout << string(84, '-') << endl;
+
+        for (const auto& scope : scopes) {
+            for (const auto& [name, results] : strategies) {
+                int tests = 0;
+                int optimal = 0;
+                double totalTime = 0.0;
+                double totalTimeToBest = 0.0;
+                double totalTimeToOptimal = 0.0;
+                double totalBestIteration = 0.0;
+                double totalIterations = 0.0;
+
+                for (const auto& r : results) {
+                    auto it = dijkstraMap.find(r.testName);
+                    if (it == dijkstraMap.end() || !inScope(scope, r)) {
+                        continue;
+                    }
+
+                    tests++;
+                    totalTime += r.executionTime;
+                    totalTimeToBest += r.timeToBest;
+                    totalBestIteration += r.bestIteration;
+                    totalIterations += r.iterations;
+
+                    if (r.foundPath && it->second.foundPath &&
+                        almostEqual(r.bestPathLength, it->second.bestPathLength)) {
+                        optimal++;
+                        totalTimeToOptimal += r.timeToBest;
+                    }
+                }
+
+                if (tests == 0) {
+                    continue;
+                }
+
+                const double optimalityRate = safePercent(optimal, tests);
+                const double avgTimeToOptimal = optimal > 0 ? totalTimeToOptimal / optimal : 0.0;
+
+                file << scope.first << "," << scope.second << "," << name << ","
+                     << tests << ","
+                     << optimalityRate << ","
+                     << totalTime / tests << ","
+                     << totalTimeToBest / tests << ","
+                     << avgTimeToOptimal << ","
+                     << totalBestIteration / tests << ","
+                     << totalIterations / tests << "\n";
+
+                cout << setw(16) << scope.second
+                     << setw(10) << name
+                     << setw(8) << tests
+                     << setw(11) << fixed << setprecision(1) << optimalityRate << "%"
+                     << setw(11) << fixed << setprecision(4) << totalTime / tests << "s"
+                     << setw(13) << fixed << setprecision(4) << avgTimeToOptimal << "s"
+                     << setw(12) << fixed << setprecision(1) << totalBestIteration / tests << endl;
+            }
+        }
+
+        cout << "Results saved to: " << filename << endl;
+    }
+
+    // Ranks sweep configurations (name, results file, parameter summary) by
+    // expected running time to the optimum: total ACO time over the suite
+    // divided by the number of tests that reached the Dijkstra length.
+    void rankConfigurations(const vector<tuple<string, string, string>>& configFiles,
+                            const string& dijkstraFile,
+                            const string& outputFile) {
+        const auto dijkstraMap = buildResultMap(loadCSV(joinPath(resultsDir, dijkstraFile)));
+        if (dijkstraMap.empty()) {
+            cerr << "Error: Dijkstra results are required to rank configurations." << endl;
+            return;
+        }
+
+        struct ConfigRank {
+            string name;
+            string parameters;
+            int tests = 0;
+            int found = 0;
+            int optimal = 0;
+            double totalTime = 0.0;
+            double totalTimeToOptimal = 0.0;
+            double totalRelativeErrorPct = 0.0;
+            double expectedTimeToOptimal = numeric_limits<double>::infinity();
+        };
+
+        vector<ConfigRank> ranks;
+        for (const auto& [name, file, parameters] : configFiles) {
+            ConfigRank rank;
+            rank.name = name;
+            rank.parameters = parameters;
+
+            for (const auto& r : loadCSV(joinPath(resultsDir, file))) {
+                auto it = dijkstraMap.find(r.testName);
+                if (it == dijkstraMap.end() || !it->second.foundPath) {
+                    continue;
+                }
+
+                rank.tests++;
+                rank.totalTime += r.executionTime;
+
+                if (!r.foundPath) {
+                    continue;
+                }
+
+                rank.found++;
+                rank.totalRelativeErrorPct += safePercent(r.bestPathLength - it->second.bestPathLength,
+                                                          it->second.bestPathLength);
+
+                if (almostEqual(r.bestPathLength, it->second.bestPathLength)) {
+                    rank.optimal++;
+                    rank.totalTimeToOptimal += r.timeToBest;
+                }
+            }
+
+            if (rank.optimal > 0) {
+                rank.expectedTimeToOptimal = rank.totalTime / rank.optimal;
+            }
+
+            ranks.push_back(rank);
+        }
+
+        // Configurations that never reach the optimum go last, ordered by
+        // how close their paths get.
+        stable_sort(ranks.begin(), ranks.end(), [](const ConfigRank& a, const ConfigRank& b) {
+            if (a.optimal > 0 && b.optimal > 0) {
+                return a.expectedTimeToOptimal < b.expectedTimeToOptimal;
+            }
+            if (a.optimal > 0 || b.optimal > 0) {
+                return a.optimal > 0;
+            }
+            return safeRatio(a.totalRelativeErrorPct, a.found) < safeRatio(b.totalRelativeErrorPct, b.found);
+        });
+
+        const string filename = joinPath(resultsDir, outputFile);
+        ofstream file(filename);
+        if (!file.is_open()) {
+            cerr << "Cannot open file for writing: " << filename << endl;
+            return;
+        }
+
+        file << "Rank,Config,Tests,SuccessRate,OptimalityRate,AvgRelativeErrorPct,AvgTime,"
+             << "AvgTimeToOptimal,ExpectedTimeToOptimal,Parameters\n";
+
+        cout << "ACO PARAMETER SWEEP RANKING (time-to-quality)" << endl;
+        cout << "===============================================================" << endl;
+        cout << setw(6) << "Rank"
+             << setw(12) << "Config"
+             << setw(12) << "Optimal%"
+             << setw(12) << "AvgErr%"
+             << setw(12) << "AvgTime"
+             << setw(14) << "ERT" << "  Parameters" << endl;
+        cout << string(84, '-') << endl;
+
+        for (size_t i = 0; i < ranks.size(); ++i) {
+            const auto& rank = ranks[i];
+            const double avgTime = safeRatio(rank.totalTime, rank.tests);
+            const double avgError = safeRatio(rank.totalRelativeErrorPct, rank.found);
+            const double avgTimeToOptimal = safeRatio(rank.totalTimeToOptimal, rank.optimal);
+
+            file << i + 1 << "," << rank.name << ","
+                 << rank.tests << ","
+                 << safePercent(rank.found, rank.tests) << ","
+                 << safePercent(rank.optimal, rank.tests) << ","
+                 << avgError << ","
+                 << avgTime << ","
+                 << avgTimeToOptimal << ","
+                 << rank.expectedTimeToOptimal << ","
+                 << "\"" << rank.parameters << "\"\n";
+
+            if (i < 10) {
+                cout << setw(6) << i + 1
+                     << setw(12) << rank.name
+                     << setw(11) << fixed << setprecision(1) << safePercent(rank.optimal, rank.tests) << "%"
+                     << setw(11) << fixed << setprecision(2) << avgError << "%"
+                     << setw(11) << fixed << setprecision(4) << avgTime << "s"
+                     << setw(13) << fixed << setprecision(4) << rank.expectedTimeToOptimal << "s"
+                     << "  " << rank.parameters << endl;
+            }
+        }
+
+        cout << "Results saved to: " << filename << endl;
+    }
+
 private:
     static string joinPath(const string& left, const string& right) {
         namespace fs = std::filesystem;
@@ -251,13 +491,40 @@ private:
             getline(ss, token, ',');
             result.iterations = token.empty() ? 0 : stoi(token);
 
-            getline(ss, result.bestPathSequence);
+            string rest;
+            getline(ss, rest);
+
+            // The path sequence is quoted; ACO result files carry extra
+            // columns after it.
+            string extraColumns;
+            if (!rest.empty() && rest.front() == '"') {
+                const size_t closing = rest.find('"', 1);
+                result.bestPathSequence = rest.substr(1, closing == string::npos ? string::npos : closing - 1);
+                if (closing != string::npos && closing + 1 < rest.size() && rest[closing + 1] == ',') {
+                    extraColumns = rest.substr(closing + 2);
+                }
+            } else {
+                result.bestPathSequence = rest;
+            }
+
+            if (!extraColumns.empty()) {
+                stringstream extra(extraColumns);
+
+                getline(extra, result.strategy, ',');
 
-            if (!result.bestPathSequence.empty() &&
-                result.bestPathSequence.front() == '"' &&
-                result.bestPathSequence.back() == '"') {
-                result.bestPathSequence =
-                    result.bestPathSequence.substr(1, result.bestPathSequence.size() - 2);
+                getline(extra, token, ',');
+                result.bestIteration = token.empty() ? 0 : stoi(token);
+
+                getline(extra, token, ',');
+                result.timeToBest = token.empty() ? 0.0 : stod(token);
+
+                if (getline(extra, token, ',') && !token.empty()) {
+                    result.seed = stoull(token);
+                }
+
+                if (getline(extra, token, ',') && !token.empty()) {
+                    result.successRate = stod(token);
+                }
             }
 
             results.push_back(result);
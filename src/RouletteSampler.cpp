@@ -0,0 +1,207 @@
+#include "RouletteSampler.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ACO_HAVE_SSE2 1
+#endif
+
+using namespace std;
+
+namespace {
+    // Rounding can leave the target at or past the last prefix sum; the
+    // last positive weight is the column the target belongs to.
+    int lastPositive(const double* masked, int n) {
+        for (int j = n - 1; j >= 0; --j) {
+            if (masked[j] > 0.0) {
+                return j;
+            }
+        }
+        return -1;
+    }
+}
+
+int RouletteSampler::linearScan(const double* weights, const uint32_t* stamps, uint32_t generation,
+                                int n, double u, double* scratch) {
+    double sum = 0.0;
+    for (int j = 0; j < n; ++j) {
+        scratch[j] = stamps[j] == generation ? 0.0 : weights[j];
+        sum += scratch[j];
+    }
+
+    if (sum <= 0.0) {
+        return -1;
+    }
+
+    const double r = u * sum;
+    double cumulative = 0.0;
+
+    for (int j = 0; j < n; ++j) {
+        if (scratch[j] > 0.0) {
+            cumulative += scratch[j];
+            if (cumulative >= r) {
+                return j;
+            }
+        }
+    }
+
+    return lastPositive(scratch, n);
+}
+
+int RouletteSampler::prefixSearch(const double* weights, const uint32_t* stamps, uint32_t generation,
+                                  int n, double u, double* scratch) {
+    double sum = 0.0;
+    for (int j = 0; j < n; ++j) {
+        sum += stamps[j] == generation ? 0.0 : weights[j];
+        scratch[j] = sum;
+    }
+
+    if (sum <= 0.0) {
+        return -1;
+    }
+
+    // First prefix strictly above the target; its own weight is positive.
+    const double r = u * sum;
+    const int j = static_cast<int>(upper_bound(scratch, scratch + n, r) - scratch);
+    if (j < n) {
+        return j;
+    }
+
+    for (int k = n - 1; k > 0; --k) {
+        if (scratch[k] > scratch[k - 1]) {
+            return k;
+        }
+    }
+    return 0;
+}
+
+int RouletteSampler::simdScan(const double* weights, const uint32_t* stamps, uint32_t generation,
+                              int n, double u, double* scratch) {
+    int j = 0;
+    double sum = 0.0;
+
+#ifdef ACO_HAVE_SSE2
+    const __m128i current = _mm_set1_epi32(static_cast<int>(generation));
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+
+    for (; j + 4 <= n; j += 4) {
+        // Widen the 32-bit visited flags to 64-bit lanes for the doubles.
+        const __m128i visited = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(stamps + j)), current);
+        const __m128d mask0 = _mm_castsi128_pd(_mm_unpacklo_epi32(visited, visited));
+        const __m128d mask1 = _mm_castsi128_pd(_mm_unpackhi_epi32(visited, visited));
+
+        const __m128d w0 = _mm_andnot_pd(mask0, _mm_loadu_pd(weights + j));
+        const __m128d w1 = _mm_andnot_pd(mask1, _mm_loadu_pd(weights + j + 2));
+
+        _mm_storeu_pd(scratch + j, w0);
+        _mm_storeu_pd(scratch + j + 2, w1);
+        acc0 = _mm_add_pd(acc0, w0);
+        acc1 = _mm_add_pd(acc1, w1);
+    }
+
+    const __m128d acc = _mm_add_pd(acc0, acc1);
+    sum = _mm_cvtsd_f64(acc) + _mm_cvtsd_f64(_mm_unpackhi_pd(acc, acc));
+#endif
+
+    for (; j < n; ++j) {
+        scratch[j] = stamps[j] == generation ? 0.0 : weights[j];
+        sum += scratch[j];
+    }
+
+    if (sum <= 0.0) {
+        return -1;
+    }
+
+    // The chosen column is the number of prefix sums not above r.
+    const double r = u * sum;
+    int count = 0;
+    j = 0;
+
+#ifdef ACO_HAVE_SSE2
+    const __m128d target = _mm_set1_pd(r);
+    __m128d carry = _mm_setzero_pd();
+
+    for (; j + 2 <= n; j += 2) {
+        const __m128d w = _mm_loadu_pd(scratch + j);
+        const __m128d prefix = _mm_add_pd(_mm_add_pd(w, _mm_unpacklo_pd(_mm_setzero_pd(), w)), carry);
+        const int below = _mm_movemask_pd(_mm_cmple_pd(prefix, target));
+
+        count += (below & 1) + (below >> 1);
+        carry = _mm_unpackhi_pd(prefix, prefix);
+    }
+
+    double cumulative = _mm_cvtsd_f64(carry);
+#else
+    double cumulative = 0.0;
+#endif
+
+    for (; j < n; ++j) {
+        cumulative += scratch[j];
+        count += cumulative <= r;
+    }
+
+    return count < n ? count : lastPositive(scratch, n);
+}
+
+void AliasTable::build(const double* weights, int n) {
+    probability.assign(n, 0.0);
+    alias.assign(n, 0);
+
+    double sum = 0.0;
+    for (int j = 0; j < n; ++j) {
+        sum += weights[j];
+    }
+
+    if (sum <= 0.0) {
+        probability.clear();
+        alias.clear();
+        return;
+    }
+
+    // Vose's method: scaled weights below 1 borrow the rest of their slot
+    // from a column above 1.
+    vector<double> scaled(n);
+    vector<int> small;
+    vector<int> large;
+    small.reserve(n);
+    large.reserve(n);
+
+    for (int j = 0; j < n; ++j) {
+        scaled[j] = weights[j] * n / sum;
+        (scaled[j] < 1.0 ? small : large).push_back(j);
+    }
+
+    while (!small.empty() && !large.empty()) {
+        const int less = small.back();
+        const int more = large.back();
+        small.pop_back();
+
+        probability[less] = scaled[less];
+        alias[less] = more;
+
+        scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+        if (scaled[more] < 1.0) {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+
+    for (int j : large) {
+        probability[j] = 1.0;
+        alias[j] = j;
+    }
+
+    // Leftovers from rounding: a zero-weight column must never keep its
+    // own slot, so point it at a column that has weight.
+    for (int j : small) {
+        if (weights[j] > 0.0) {
+            probability[j] = 1.0;
+            alias[j] = j;
+        } else {
+            probability[j] = 0.0;
+            alias[j] = large.empty() ? static_cast<int>(max_element(weights, weights + n) - weights) : large.front();
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Roulette-wheel selection over one row of choice weights, skipping the
+// vertices whose stamp equals the current generation (already visited).
+// Every method takes a uniform u in [0, 1), returns the chosen column or -1
+// when no unvisited column has a positive weight, and uses scratch (at
+// least n doubles) as work space.
+class RouletteSampler {
+public:
+    // Masked weights, then a cumulative scan. Reference method.
+    static int linearScan(const double* weights, const std::uint32_t* stamps, std::uint32_t generation,
+                          int n, double u, double* scratch);
+
+    // One pass building inclusive prefix sums, then a binary search.
+    static int prefixSearch(const double* weights, const std::uint32_t* stamps, std::uint32_t generation,
+                            int n, double u, double* scratch);
+
+    // SSE2 masking and summation, then a branch-free count of the prefix
+    // sums not above the target. Falls back to scalar code without SSE2.
+    static int simdScan(const double* weights, const std::uint32_t* stamps, std::uint32_t generation,
+                        int n, double u, double* scratch);
+};
+
+// Walker alias table over a full row of weights, visited vertices
+// included. Sampling is O(1); callers reject visited draws and fall back
+// to an exact method after a few misses, which keeps the distribution
+// exactly proportional to the unvisited weights.
+class AliasTable {
+public:
+    void build(const double* weights, int n);
+
+    bool empty() const {
+        return probability.empty();
+    }
+
+    int sample(double u) const {
+        const double scaled = u * static_cast<double>(probability.size());
+        const int column = static_cast<int>(scaled);
+        return scaled - column < probability[column] ? column : alias[column];
+    }
+
+private:
+    std::vector<double> probability;
+    std::vector<int> alias;
+};
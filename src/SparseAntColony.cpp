@@ -0,0 +1,387 @@
+#include "SparseAntColony.h"
+#include "ThreadPool.h"
+#include "Dijkstra.h"
+
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+    const int MIN_ANTS_PER_THREAD = 8;
+
+    // Defaults for zero counts. Sparse inputs reach 10^6 vertices, so
+    // unlike AntColony these do not grow with the graph.
+    const int DEFAULT_ANTS = 32;
+    const int DEFAULT_MAX_ITERATIONS = 1000;
+    const int DEFAULT_STAGNATION_LIMIT = 100;
+}
+
+SparseAntColony::SparseAntColony(CsrGraph g,
+                                 VertexLabels names,
+                                 int s,
+                                 int e,
+                                 const ACOParameters& params)
+    : n(g.vertexCount),
+      start(s),
+      end(e),
+      graph(move(g)),
+      labels(move(names)),
+      alpha(params.alpha),
+      beta(params.beta),
+      evaporation(params.evaporation),
+      Q(params.Q),
+      alphaPower(powerKind(params.alpha)),
+      numAnts(params.numAnts > 0 ? params.numAnts : DEFAULT_ANTS),
+      maxIterations(params.maxIterations > 0 ? params.maxIterations : DEFAULT_MAX_ITERATIONS),
+      stagnationLimit(params.stagnationLimit > 0 ? params.stagnationLimit : DEFAULT_STAGNATION_LIMIT),
+      logLevel(params.logLevel),
+      timeBudget(params.timeBudget),
+      targetLength(params.targetLength),
+      tauMin(ELITIST_TAU_MIN),
+      tauMax(ELITIST_TAU_MAX),
+      seed(resolveSeed(params.seed)),
+      iteration(0),
+      numThreads(ThreadPool::resolveThreadCount(params.numThreads, numAnts, MIN_ANTS_PER_THREAD))
+{
+    int maxDegree = 0;
+    for (int v = 0; v < n; ++v) {
+        maxDegree = max(maxDegree, graph.degree(v));
+    }
+
+    workers.resize(numThreads);
+    for (auto& worker : workers) {
+        worker.visitStamp.assign(n, 0);
+        worker.probabilities.assign(maxDegree, 0.0);
+    }
+
+    pheromone.assign(graph.edgeCount, static_cast<PheromoneValue>(1.0));
+
+    vector<double> toEnd(n, 0.0);
+    if (params.heuristic == HeuristicMode::GoalDirected) {
+        toEnd = Dijkstra::distancesFrom(graph, end);
+    }
+
+    const size_t arcCount = graph.targets.size();
+    heuristicPow.assign(arcCount, 0.0);
+    for (size_t arc = 0; arc < arcCount; ++arc) {
+        const double remaining = toEnd[graph.targets[arc]];
+        if (remaining < numeric_limits<double>::infinity()) {
+            heuristicPow[arc] = pow(1.0 / (graph.weights[arc] + remaining), beta);
+        }
+    }
+
+    choiceInfo.assign(arcCount, 0.0);
+    updateChoiceInfo();
+}
+
+SparseAntColony::~SparseAntColony() = default;
+
+vector<string> SparseAntColony::unsupportedOptions(const ACOParameters& params) {
+    vector<string> options;
+
+    if (params.strategy != ACOStrategy::Elitist) {
+        options.push_back(string("--strategy ") + strategyName(params.strategy));
+    }
+    if (params.candidateListSize > 0) {
+        options.push_back("--candidates");
+    }
+    if (params.sampling != SamplingMethod::Linear) {
+        options.push_back(string("--sampling ") + samplingName(params.sampling));
+    }
+    if (params.antBatch > 1) {
+        options.push_back("--ant-batch");
+    }
+    if (params.lazyEvaporation) {
+        options.push_back("--lazy-evaporation");
+    }
+    if (params.pruneDeadEnds) {
+        options.push_back("--prune-dead-ends");
+    }
+    if (params.repairAnts) {
+        options.push_back("--repair-ants");
+    }
+    if (params.branchAndBound) {
+        options.push_back("--branch-and-bound");
+    }
+
+    return options;
+}
+
+int SparseAntColony::selectNext(int current, Worker& worker) {
+    const int first = graph.offsets[current];
+    const int count = graph.offsets[current + 1] - first;
+    vector<double>& weights = worker.probabilities;
+    double sum = 0.0;
+
+    for (int a = 0; a < count; ++a) {
+        const int arc = first + a;
+        weights[a] = worker.visitStamp[graph.targets[arc]] == worker.generation ? 0.0 : choiceInfo[arc];
+        sum += weights[a];
+    }
+
+    if (sum <= 0.0) {
+        return -1;
+    }
+
+    const double r = worker.rng.uniform() * sum;
+    double cumulative = 0.0;
+    int fallback = -1;
+
+    for (int a = 0; a < count; ++a) {
+        if (weights[a] > 0.0) {
+            cumulative += weights[a];
+            if (cumulative >= r) {
+                return first + a;
+            }
+            if (fallback == -1) {
+                fallback = first + a;
+            }
+        }
+    }
+
+    return fallback;
+}
+
+void SparseAntColony::evaporatePheromones() {
+    const PheromoneValue keep = static_cast<PheromoneValue>(1.0 - evaporation);
+    const PheromoneValue floor = static_cast<PheromoneValue>(tauMin);
+
+    for (auto& tau : pheromone) {
+        const PheromoneValue decayed = tau * keep;
+        tau = decayed < floor ? floor : decayed;
+    }
+}
+
+void SparseAntColony::updateChoiceInfo() {
+    const size_t arcCount = choiceInfo.size();
+
+    dispatchPower(alphaPower, alpha, [&](auto power) {
+        for (size_t arc = 0; arc < arcCount; ++arc) {
+            choiceInfo[arc] = power(static_cast<double>(pheromone[graph.edgeIds[arc]])) * heuristicPow[arc];
+        }
+    });
+}
+
+void SparseAntColony::depositPath(const vector<int>& arcs, double pathLength, double multiplier) {
+    if (arcs.empty() || pathLength <= 0.0 || pathLength == numeric_limits<double>::max()) {
+        return;
+    }
+
+    const double pheromoneAmount = multiplier * (Q / pathLength);
+
+    for (int arc : arcs) {
+        PheromoneValue& tau = pheromone[graph.edgeIds[arc]];
+        tau = static_cast<PheromoneValue>(min(tauMax, tau + pheromoneAmount));
+    }
+}
+
+void SparseAntColony::constructAnt(int antIndex, Worker& worker) {
+    worker.generation++;
+    if (worker.generation == 0) {
+        fill(worker.visitStamp.begin(), worker.visitStamp.end(), 0);
+        worker.generation = 1;
+    }
+
+    vector<int>& path = worker.path;
+    vector<int>& arcs = worker.arcs;
+    path.clear();
+    arcs.clear();
+    double pathLength = 0.0;
+
+    path.push_back(start);
+    worker.visitStamp[start] = worker.generation;
+
+    worker.rng = PhiloxStream(seed, static_cast<uint32_t>(iteration), static_cast<uint32_t>(antIndex));
+
+    while (path.back() != end) {
+        worker.rng.setStep(static_cast<uint32_t>(path.size() - 1));
+        const int arc = selectNext(path.back(), worker);
+
+        if (arc == -1) {
+            return;
+        }
+
+        const int next = graph.targets[arc];
+        path.push_back(next);
+        arcs.push_back(arc);
+        worker.visitStamp[next] = worker.generation;
+        pathLength += graph.weights[arc];
+    }
+
+    worker.successful++;
+
+    // Ants of a worker run in index order, so the strict test keeps the
+    // lowest index among equal lengths. Swapping hands the old best's
+    // storage back as scratch.
+    if (worker.bestAnt == -1 || pathLength < worker.bestLength) {
+        swap(worker.bestPath, path);
+        swap(worker.bestArcs, arcs);
+        worker.bestLength = pathLength;
+        worker.bestAnt = antIndex;
+    }
+}
+
+void SparseAntColony::constructAnts() {
+    auto task = [this](int w) {
+        const int first = static_cast<int>(static_cast<long long>(numAnts) * w / numThreads);
+        const int last = static_cast<int>(static_cast<long long>(numAnts) * (w + 1) / numThreads);
+
+        Worker& worker = workers[w];
+        worker.bestAnt = -1;
+        worker.successful = 0;
+
+        for (int k = first; k < last; ++k) {
+            constructAnt(k, worker);
+        }
+    };
+
+    if (pool) {
+        pool->runOnAll(task);
+    } else {
+        task(0);
+    }
+}
+
+ACOResult SparseAntColony::run() {
+    ACORunControl control;
+    control.timeBudget = timeBudget;
+    control.targetLength = targetLength;
+    return run(control);
+}
+
+ACOResult SparseAntColony::run(const ACORunControl& control) {
+    ACOResult result;
+    result.seed = seed;
+
+    if (n == 0 || start < 0 || end < 0 || start >= n || end >= n) {
+        return result;
+    }
+
+    vector<int> globalBestPath;
+    vector<int> globalBestArcs;
+    double globalBestLength = numeric_limits<double>::max();
+
+    int noImprovement = 0;
+    bool foundAnyPathEver = false;
+
+    if (numThreads > 1 && !pool) {
+        pool = make_unique<ThreadPool>(numThreads);
+    }
+
+    const auto runStart = chrono::steady_clock::now();
+
+    for (int it = 0; it < maxIterations; ++it) {
+        result.iterations = it + 1;
+        iteration = it;
+
+        constructAnts();
+
+        const Worker* iterationBest = nullptr;
+
+        ACOIterationStats stats;
+        stats.ants = numAnts;
+
+        // Workers hold consecutive ant ranges, so reducing in worker order
+        // with a strict test picks the same ant for any thread count.
+        for (const auto& worker : workers) {
+            stats.successful += worker.successful;
+
+            if (worker.bestAnt != -1 && (!iterationBest || worker.bestLength < iterationBest->bestLength)) {
+                iterationBest = &worker;
+            }
+        }
+
+        if (iterationBest) {
+            foundAnyPathEver = true;
+
+            if (iterationBest->bestLength < globalBestLength) {
+                globalBestLength = iterationBest->bestLength;
+                globalBestPath = iterationBest->bestPath;
+                globalBestArcs = iterationBest->bestArcs;
+                result.pathFound = true;
+            }
+        }
+
+        stats.bestLength = globalBestLength;
+        result.history.push_back(stats);
+
+        evaporatePheromones();
+
+        if (iterationBest) {
+            depositPath(iterationBest->bestArcs, iterationBest->bestLength, 2.0);
+        }
+
+        if (result.pathFound) {
+            depositPath(globalBestArcs, globalBestLength, 3.0);
+        }
+
+        updateChoiceInfo();
+
+        bool improved = false;
+        if (result.pathFound && globalBestLength < result.bestLength) {
+            result.bestLength = globalBestLength;
+            result.bestPath = globalBestPath;
+            result.bestIteration = it + 1;
+            result.timeToBest = chrono::duration<double>(chrono::steady_clock::now() - runStart).count();
+            improved = true;
+        }
+
+        if (improved) {
+            noImprovement = 0;
+        } else {
+            noImprovement++;
+        }
+
+        const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - runStart).count();
+
+        if (control.wantsProgress(it + 1, improved)) {
+            control.onProgress(ACOProgress{it + 1, elapsed, globalBestLength, globalBestPath, improved});
+        }
+
+        if (logLevel >= LogLevel::Progress && it % 10 == 0) {
+            LogLine line;
+            line << "Iteration " << it + 1;
+            if (result.pathFound) {
+                line << " - Best: " << result.bestLength;
+            } else {
+                line << " - No path found yet";
+            }
+        }
+
+        if (control.shouldStop(result.pathFound, result.bestLength, elapsed, result.stopReason)) {
+            if (logLevel >= LogLevel::Progress) {
+                LogLine() << "Stopped after " << it + 1 << " iterations: "
+                          << stopReasonName(result.stopReason) << ".";
+            }
+            break;
+        }
+
+        if (foundAnyPathEver && noImprovement >= stagnationLimit) {
+            result.stopReason = ACOStopReason::Stagnation;
+            if (logLevel >= LogLevel::Progress) {
+                LogLine() << "Stopped early after " << it + 1
+                          << " iterations due to stagnation.";
+            }
+            break;
+        }
+    }
+
+    if (result.pathFound) {
+        result.bestPathLabels = labels.join(result.bestPath, " -> ");
+
+        if (logLevel >= LogLevel::Result) {
+            LogLine() << "SUCCESS: Path found: " << result.bestPathLabels
+                      << " (length: " << result.bestLength
+                      << ", iterations: " << result.iterations << ")";
+        }
+    } else {
+        result.bestLength = numeric_limits<double>::max();
+        if (logLevel >= LogLevel::Result) {
+            LogLine() << "FAIL: No path found from " << labels[start]
+                      << " to " << labels[end];
+        }
+    }
+
+    return result;
+}
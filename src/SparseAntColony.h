@@ -0,0 +1,101 @@
+#pragma once
+
+#include "AntColony.h"
+#include "CsrGraph.h"
+#include "PheromoneMatrix.h"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <memory>
+
+class ThreadPool;
+
+// Ant colony over a CSR graph for large sparse inputs. Pheromone is indexed
+// by edge id and every per-vertex structure is O(n), so memory stays
+// O(n + m) instead of O(n^2). Tours are built in per-worker scratch and
+// only the iteration best and global best are kept, so the ant count adds
+// nothing to the footprint. The tour construction follows AntColony; the
+// update is the elitist one without the per-ant deposits, which would need
+// every tour of the iteration.
+class SparseAntColony {
+private:
+    // Visit stamps and the tour live in the worker rather than the ant: an
+    // ant only needs them while it is being built. arcs[i] is the CSR arc
+    // taken from path[i] to path[i + 1].
+    struct Worker {
+        PhiloxStream rng;
+        std::vector<std::uint32_t> visitStamp;
+        std::uint32_t generation = 0;
+        std::vector<double> probabilities;
+        std::vector<int> path;
+        std::vector<int> arcs;
+
+        // Shortest tour this worker completed in the current iteration,
+        // the lowest ant index winning ties.
+        std::vector<int> bestPath;
+        std::vector<int> bestArcs;
+        double bestLength = 0.0;
+        int bestAnt = -1;
+        int successful = 0;
+    };
+
+    int n;
+    int start;
+    int end;
+
+    CsrGraph graph;
+    VertexLabels labels;
+
+    std::vector<PheromoneValue> pheromone;
+    std::vector<double> heuristicPow;
+    std::vector<double> choiceInfo;
+
+    double alpha;
+    double beta;
+    double evaporation;
+    double Q;
+    PowerKind alphaPower;
+
+    int numAnts;
+    int maxIterations;
+    int stagnationLimit;
+    LogLevel logLevel;
+    double timeBudget;
+    double targetLength;
+
+    double tauMin;
+    double tauMax;
+
+    std::uint64_t seed;
+    int iteration;
+
+    int numThreads;
+    std::vector<Worker> workers;
+    std::unique_ptr<ThreadPool> pool;
+
+private:
+    int selectNext(int current, Worker& worker);
+    void constructAnt(int antIndex, Worker& worker);
+    void constructAnts();
+    void evaporatePheromones();
+    void updateChoiceInfo();
+    void depositPath(const std::vector<int>& arcs, double pathLength, double multiplier = 1.0);
+
+public:
+    SparseAntColony(CsrGraph g,
+                    VertexLabels names,
+                    int s,
+                    int e,
+                    const ACOParameters& params = ACOParameters());
+
+    ~SparseAntColony();
+
+    ACOResult run();
+    ACOResult run(const ACORunControl& control);
+
+    // Command-line names of the options in params that only AntColony
+    // implements. The sparse engine always runs the elitist update with
+    // a full-neighbourhood roulette and would silently ignore them.
+    static std::vector<std::string> unsupportedOptions(const ACOParameters& params);
+};
@@ -1,5 +1,6 @@
 #include "TestRunner.h"
 #include "AntColony.h"
+#include "SparseAntColony.h"
 #include "FileReader.h"
 
 #include <iostream>
@@ -10,6 +11,20 @@
 using namespace std;
 namespace fs = std::filesystem;
 
+namespace {
+    template <typename Colony>
+    double timedRun(Colony& colony, ACOResult& result) {
+        auto startTime = chrono::high_resolution_clock::now();
+        result = colony.run();
+        auto endTime = chrono::high_resolution_clock::now();
+
+        return chrono::duration<double>(endTime - startTime).count();
+    }
+}
+
+TestRunner::TestRunner(const ACOParameters& params)
+    : acoParameters(params) {}
+
 int TestRunner::countEdges(const vector<vector<double>>& graph) {
     int n = static_cast<int>(graph.size());
     int edgeCount = 0;
@@ -54,6 +69,14 @@ string TestRunner::getDefaultOutputFile() const {
     return "results/aco_results.csv";
 }
 
+bool TestRunner::writesAcoColumns() const {
+    return true;
+}
+
+void TestRunner::setOutputFile(const string& filename) {
+    outputFile = filename;
+}
+
 void TestRunner::clearResults() {
     results.clear();
 }
@@ -61,8 +84,12 @@ void TestRunner::clearResults() {
 void TestRunner::runTestSuite(const string& testDirectory) {
     clearResults();
 
-    cout << "=== ACO Algorithm Test Suite ===" << endl;
-    cout << "Looking for test files in: " << testDirectory << endl;
+    const bool verbose = acoParameters.logLevel != LogLevel::Off;
+
+    if (verbose) {
+        cout << "=== ACO Algorithm Test Suite ===" << endl;
+        cout << "Looking for test files in: " << testDirectory << endl;
+    }
 
     vector<string> testFiles = readTestFilesList(testDirectory);
 
@@ -72,7 +99,9 @@ void TestRunner::runTestSuite(const string& testDirectory) {
         return;
     }
 
-    cout << "Found " << testFiles.size() << " test files in the list." << endl;
+    if (verbose) {
+        cout << "Found " << testFiles.size() << " test files in the list." << endl;
+    }
 
     int testCount = 0;
     const int maxTests = min(100, static_cast<int>(testFiles.size()));
@@ -92,7 +121,9 @@ void TestRunner::runTestSuite(const string& testDirectory) {
             testName = testName.substr(0, dotPos);
         }
 
-        cout << "[" << (testCount + 1) << "] Running: " << testName << endl;
+        if (verbose) {
+            cout << "[" << (testCount + 1) << "] Running: " << testName << endl;
+        }
         runSingleTest(fullPath, testName);
         testCount++;
     }
@@ -103,51 +134,86 @@ void TestRunner::runTestSuite(const string& testDirectory) {
         return;
     }
 
-    cout << "\n=== Completed " << testCount << " tests ===" << endl;
-    printSummary();
-    saveResultsToCSV(getDefaultOutputFile());
+    if (verbose) {
+        cout << "\n=== Completed " << testCount << " tests ===" << endl;
+        printSummary();
+    }
+    saveResultsToCSV(outputFile.empty() ? getDefaultOutputFile() : outputFile);
 }
 
 void TestRunner::runSingleTest(const string& graphFile, const string& testName) {
-    bool fileLoaded = false;
-    vector<vector<double>> graph;
-    vector<string> labels;
     int start = -1;
     int end = -1;
 
-    readGraphFromFile(graphFile, fileLoaded, graph, labels, start, end);
+    // Edge lists go straight to the sparse engine without a dense matrix.
+    const bool edgeList = isEdgeListFile(graphFile);
+    GraphPtr graph;
+    CsrGraph sparseGraph;
+    const VertexLabels generatedLabels;
 
-    if (!fileLoaded || graph.empty()) {
+    bool loaded;
+    if (edgeList) {
+        loaded = loadEdgeList(graphFile, sparseGraph, start, end);
+    } else {
+        graph = loadGraph(graphFile, start, end);
+        loaded = graph != nullptr;
+    }
+
+    if (!loaded) {
         cerr << "  Failed to load graph: " << graphFile << endl;
         return;
     }
 
-    const int n = static_cast<int>(labels.size());
-    if (n == 0) {
-        cerr << "  Empty graph: " << graphFile << endl;
-        return;
+    const VertexLabels& labels = edgeList ? generatedLabels : graph->labels();
+    const int n = edgeList ? sparseGraph.vertexCount : graph->size();
+    const int edges = edgeList ? sparseGraph.edgeCount : countEdges(graph->matrix());
+    const bool verbose = acoParameters.logLevel != LogLevel::Off;
+
+    if (verbose) {
+        cout << "  Path: " << labels[start] << " -> " << labels[end];
+        cout << " (vertices: " << n << ", edges: " << edges << ")" << endl;
     }
 
-    cout << "  Path: " << labels[start] << " -> " << labels[end];
-    cout << " (vertices: " << n << ", edges: " << countEdges(graph) << ")" << endl;
+    ACOResult result;
+    double executionTime = 0.0;
 
-    AntColony colony(graph, labels, start, end);
+    // The sparse engine always runs the elitist update; record that rather
+    // than the strategy that was asked for.
+    const bool sparse = edgeList || acoParameters.engine == ACOEngine::Sparse;
+    const ACOStrategy strategy = sparse ? ACOStrategy::Elitist : acoParameters.strategy;
 
-    auto startTime = chrono::high_resolution_clock::now();
-    ACOResult result = colony.run();
-    auto endTime = chrono::high_resolution_clock::now();
+    if (sparse && !warnedSparseOptions) {
+        const vector<string> unsupported = SparseAntColony::unsupportedOptions(acoParameters);
+        if (!unsupported.empty()) {
+            cerr << "Warning: the sparse engine ignores";
+            for (size_t i = 0; i < unsupported.size(); ++i) {
+                cerr << (i == 0 ? " " : ", ") << unsupported[i];
+            }
+            cerr << endl;
+        }
+        warnedSparseOptions = true;
+    }
+
+    if (edgeList) {
+        SparseAntColony colony(move(sparseGraph), labels, start, end, acoParameters);
+        executionTime = timedRun(colony, result);
+    } else if (acoParameters.engine == ACOEngine::Sparse) {
+        SparseAntColony colony(CsrGraph::fromAdjacencyMatrix(graph->matrix()), labels, start, end, acoParameters);
+        executionTime = timedRun(colony, result);
+    } else {
+        AntColony colony(graph, start, end, acoParameters);
+        executionTime = timedRun(colony, result);
+    }
 
-    const double executionTime = chrono::duration<double>(endTime - startTime).count();
+    // The colony only queued its lines; print them before ours, outside
+    // the timed region.
+    if (verbose) {
+        AsyncLog::instance().flush();
+    }
 
     string pathSequence = "NO_PATH";
     if (result.pathFound && !result.bestPath.empty()) {
-        pathSequence.clear();
-        for (size_t i = 0; i < result.bestPath.size(); i++) {
-            pathSequence += labels[result.bestPath[i]];
-            if (i < result.bestPath.size() - 1) {
-                pathSequence += "->";
-            }
-        }
+        pathSequence = labels.join(result.bestPath, "->");
     }
 
     TestResult testResult;
@@ -155,13 +221,22 @@ void TestRunner::runSingleTest(const string& graphFile, const string& testName)
     testResult.executionTime = executionTime;
     testResult.bestPathLength = result.bestLength;
     testResult.vertices = n;
-    testResult.edges = countEdges(graph);
+    testResult.edges = edges;
     testResult.foundPath = result.pathFound;
     testResult.iterations = result.iterations;
     testResult.bestPathSequence = pathSequence;
+    testResult.strategy = strategyName(strategy);
+    testResult.bestIteration = result.bestIteration;
+    testResult.timeToBest = result.timeToBest;
+    testResult.seed = result.seed;
+    testResult.successRate = result.averageSuccessRate();
 
     results.push_back(testResult);
 
+    if (!verbose) {
+        return;
+    }
+
     cout << "  Result: time=" << executionTime << "s, length=";
     if (result.pathFound) {
         cout << result.bestLength;
@@ -170,7 +245,18 @@ void TestRunner::runSingleTest(const string& graphFile, const string& testName)
     }
 
     cout << ", found=" << (result.pathFound ? "yes" : "no")
-         << ", iterations=" << result.iterations << endl;
+         << ", iterations=" << result.iterations
+         << ", best_iteration=" << result.bestIteration
+         << ", time_to_best=" << result.timeToBest << "s"
+         << ", seed=" << result.seed
+         << ", success_rate=" << result.averageSuccessRate()
+         << ", stop=" << stopReasonName(result.stopReason);
+
+    if (result.restarts > 0) {
+        cout << ", restarts=" << result.restarts;
+    }
+
+    cout << endl;
 }
 
 void TestRunner::saveResultsToCSV(const string& filename) {
@@ -182,7 +268,13 @@ void TestRunner::saveResultsToCSV(const string& filename) {
         return;
     }
 
-    file << "TestName,Vertices,Edges,Time,PathLength,FoundPath,Iterations,PathSequence\n";
+    const bool acoColumns = writesAcoColumns();
+
+    file << "TestName,Vertices,Edges,Time,PathLength,FoundPath,Iterations,PathSequence";
+    if (acoColumns) {
+        file << ",Strategy,BestIteration,TimeToBest,Seed,SuccessRate";
+    }
+    file << "\n";
 
     for (const auto& result : results) {
         file << result.testName << ","
@@ -192,10 +284,22 @@ void TestRunner::saveResultsToCSV(const string& filename) {
              << result.bestPathLength << ","
              << (result.foundPath ? "true" : "false") << ","
              << result.iterations << ","
-             << "\"" << result.bestPathSequence << "\"\n";
+             << "\"" << result.bestPathSequence << "\"";
+
+        if (acoColumns) {
+            file << "," << result.strategy
+                 << "," << result.bestIteration
+                 << "," << result.timeToBest
+                 << "," << result.seed
+                 << "," << result.successRate;
+        }
+
+        file << "\n";
     }
 
-    cout << "Results saved to: " << filename << endl;
+    if (acoParameters.logLevel != LogLevel::Off) {
+        cout << "Results saved to: " << filename << endl;
+    }
 }
 
 void TestRunner::printSummary() {
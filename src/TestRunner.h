@@ -6,6 +6,8 @@
 #include <fstream>
 #include <random>
 
+#include "AntColony.h"
+
 using namespace std;
 
 struct TestResult {
@@ -17,6 +19,13 @@ struct TestResult {
     bool foundPath;
     int iterations;
     string bestPathSequence;
+
+    // ACO-only columns.
+    string strategy;
+    int bestIteration = 0;
+    double timeToBest = 0.0;
+    unsigned long long seed = 0;
+    double successRate = 0.0;
 };
 
 void readGraphFromFile(const string& filename, bool& fileLoaded, vector<vector<double>>& graph, vector<string>& labels, int& start, int& end);
@@ -26,14 +35,27 @@ class TestRunner {
 public:
     vector<TestResult> results;
 
+    explicit TestRunner(const ACOParameters& params = ACOParameters());
+    virtual ~TestRunner() = default;
+
     int countEdges(const vector<vector<double>>& graph);
     bool fileExists(const string& filename);
 
     virtual string getDefaultOutputFile() const;
+    virtual bool writesAcoColumns() const;
     virtual void runTestSuite(const string& testDirectory);
     virtual void runSingleTest(const string& graphFile, const string& testName);
 
+    void setOutputFile(const string& filename);
     void clearResults();
     void saveResultsToCSV(const string& filename);
     void printSummary();
+
+protected:
+    ACOParameters acoParameters;
+    string outputFile;
+
+    // Set once the options the sparse engine ignores have been reported,
+    // so a suite of edge lists warns only once.
+    bool warnedSparseOptions = false;
 };
\ No newline at end of file
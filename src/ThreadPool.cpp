@@ -0,0 +1,94 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+ThreadPool::ThreadPool(int threadCount)
+    : currentTask(nullptr),
+      generation(0),
+      pending(0),
+      stopping(false)
+{
+    const int count = max(1, threadCount);
+    threads.reserve(count - 1);
+
+    for (int worker = 1; worker < count; ++worker) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(stateMutex);
+        stopping = true;
+    }
+    taskReady.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+int ThreadPool::size() const {
+    return static_cast<int>(threads.size()) + 1;
+}
+
+int ThreadPool::resolveThreadCount(int requested, int tasks, int minTasksPerThread) {
+    if (requested <= 0) {
+        const int hardware = static_cast<int>(thread::hardware_concurrency());
+        requested = min(max(1, hardware), tasks / max(1, minTasksPerThread));
+    }
+    return max(1, min(requested, tasks));
+}
+
+void ThreadPool::runOnAll(const function<void(int)>& task) {
+    if (threads.empty()) {
+        task(0);
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(stateMutex);
+        currentTask = &task;
+        pending = static_cast<int>(threads.size());
+        generation++;
+    }
+    taskReady.notify_all();
+
+    task(0);
+
+    unique_lock<mutex> lock(stateMutex);
+    taskDone.wait(lock, [this] { return pending == 0; });
+    currentTask = nullptr;
+}
+
+void ThreadPool::workerLoop(int worker) {
+    unsigned long long seenGeneration = 0;
+
+    while (true) {
+        const function<void(int)>* task = nullptr;
+        {
+            unique_lock<mutex> lock(stateMutex);
+            taskReady.wait(lock, [this, seenGeneration] {
+                return stopping || generation != seenGeneration;
+            });
+
+            if (stopping) {
+                return;
+            }
+
+            seenGeneration = generation;
+            task = currentTask;
+        }
+
+        (*task)(worker);
+
+        {
+            lock_guard<mutex> lock(stateMutex);
+            pending--;
+        }
+        taskDone.notify_one();
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads that execute one task per worker and wait
+// for all of them to finish. Worker 0 is the calling thread.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const;
+
+    // Maps a requested thread count (0 = hardware concurrency) onto a value
+    // that leaves at least minTasksPerThread tasks for every thread.
+    static int resolveThreadCount(int requested, int tasks, int minTasksPerThread);
+
+    void runOnAll(const std::function<void(int)>& task);
+
+private:
+    std::vector<std::thread> threads;
+
+    std::mutex stateMutex;
+    std::condition_variable taskReady;
+    std::condition_variable taskDone;
+
+    const std::function<void(int)>* currentTask;
+    unsigned long long generation;
+    int pending;
+    bool stopping;
+
+    void workerLoop(int worker);
+};
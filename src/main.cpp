@@ -1,9 +1,14 @@
 #include "AntColony.h"
+#include "SparseAntColony.h"
 #include "FileReader.h"
 #include "PipelineRunner.h"
 #include "GenerateTestSuite.h"
+#include "ParameterFile.h"
+#include "Benchmarks.h"
+#include "MultiColony.h"
 
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <filesystem>
@@ -14,17 +19,57 @@ namespace fs = std::filesystem;
 namespace {
     const string DEFAULT_TEST_DIR = "data/test_cases";
     const string DEFAULT_RESULTS_DIR = "results";
+    const string TUNED_PARAMETERS_FILE = "results/aco_tuned_params.txt";
 
     void printHelp() {
         cout << "Usage:\n";
         cout << "  ./aco --help\n";
         // cout << "  ./aco --interactive\n";
-        cout << "  ./aco --single <graph_file>\n";
+        cout << "  ./aco --single <graph_file> [--colonies <k> [island options]] [aco options]\n";
+        cout << "        (a .edges file is read as an edge list and runs on the sparse engine)\n";
         cout << "  ./aco --generate-tests [--test-dir <dir>]\n";
-        cout << "  ./aco --run <aco|dj|bf|fw|astar> [--test-dir <dir>]\n";
+        cout << "  ./aco --run <aco|dj|bf|fw|astar> [--test-dir <dir>] [aco options]\n";
         // cout << "  ./aco --run-all [--test-dir <dir>]\n";
         cout << "  ./aco --analyze\n";
-        cout << "  ./aco --full-pipeline [--test-dir <dir>]\n";
+        cout << "  ./aco --compare-strategies [--test-dir <dir>] [aco options]\n";
+        cout << "  ./aco --sweep <grid_file> [--test-dir <dir>] [--sweep-threads <n>] [aco options]\n";
+        cout << "  ./aco --autotune [grid_file] [--tune-sample <n>] [--tune-threads <n>] [--tune-output <file>] [aco options]\n";
+        cout << "  ./aco --full-pipeline [--test-dir <dir>] [aco options]\n";
+        cout << "  ./aco --benchmark <name> [--test-dir <dir>] [aco options]\n";
+        cout << "\nIsland options (--single with --colonies k > 1):\n";
+        cout << "  --migration-interval <m>  iterations between migrations along the ring (default 10, 0 = never)\n";
+        cout << "  --migration-blend <w>     weight of the neighbour's pheromone when blending (default 0.25)\n";
+        cout << "  --colony-alpha <a,b,...>  per-colony alpha, cycled over the colonies\n";
+        cout << "  --colony-beta <a,b,...>   per-colony beta, cycled over the colonies\n";
+        cout << "  --colony-threads <n>      threads running colonies (0 = auto)\n";
+        cout << "\nACO options:\n";
+        cout << "  --params <file>     load parameters from a key = value file (options below override it);\n";
+        cout << "                      without it --run aco uses " << TUNED_PARAMETERS_FILE << " from --autotune if present\n";
+        cout << "  --alpha <a>         pheromone exponent (default 1)\n";
+        cout << "  --beta <b>          heuristic exponent (default 3)\n";
+        cout << "  --evaporation <r>   evaporation rate in (0, 1] (default 0.3)\n";
+        cout << "  --q <q>             deposit constant (default 100)\n";
+        cout << "  --ants <n>          ants per iteration (0 = max(10, vertices))\n";
+        cout << "  --iterations <n>    iteration limit (0 = max(100, 20 * vertices))\n";
+        cout << "  --stagnation <n>    stop after n iterations without improvement (0 = max(20, vertices / 2))\n";
+        cout << "  --candidates <k>    nearest-neighbour candidate list size (0 = full neighbourhood)\n";
+        cout << "  --threads <n>       threads used to construct ants (0 = auto)\n";
+        cout << "  --ant-batch <k>     ants per thread built in lockstep, rounded up to 8 or 16 (0 = one at a time, dense engine)\n";
+        cout << "  --strategy <elitist|mmas|acs>  pheromone update strategy (dense engine)\n";
+        cout << "  --engine <dense|sparse>  dense matrix colony or CSR colony for large sparse graphs\n";
+        cout << "                      (sparse runs elitist only and refuses dense-only options)\n";
+        cout << "  --lazy-evaporation  evaporate pheromone on read instead of sweeping the matrix\n";
+        cout << "  --prune-dead-ends   never enter vertices that lie on no simple start-end path (dense engine)\n";
+        cout << "  --repair-ants       finish stuck ants along the shortest-path tree to end (dense engine)\n";
+        cout << "  --branch-and-bound  abandon ants whose length plus distance to end exceeds the best path (dense engine)\n";
+        cout << "  --heuristic <inverse|goal>  eta = 1/w(i,j) or goal-directed 1/(w(i,j) + d(j,end))\n";
+        cout << "  --sampling <linear|prefix|alias|simd>  roulette-wheel method over full rows (dense engine)\n";
+        cout << "  --acs-q0 <q0>       ACS probability of taking the best edge outright (default 0.5)\n";
+        cout << "  --acs-local-evaporation <xi>  ACS local evaporation rate (default 0.1)\n";
+        cout << "  --log-level <off|result|progress>  console output of the colonies (default progress)\n";
+        cout << "  --time-budget <s>   stop each run after s seconds of wall-clock time and keep the best path so far\n";
+        cout << "  --target-length <L> stop each run once a path of length <= L is found\n";
+        cout << "  --seed <n>          random seed; equal seeds give identical runs for any --threads (0 = random)\n";
     }
 
     string getOptionValue(const vector<string>& args, const string& key, const string& defaultValue) {
@@ -45,40 +90,245 @@ namespace {
         return false;
     }
 
-    int runSingleGraphMode(const string& filename) {
-        bool fileLoaded = false;
-        vector<vector<double>> graph;
-        vector<string> labels;
+    void reportInvalidOption(const string& option, const string& value, const char* expected) {
+        cerr << "Error: " << option << " expects " << expected << ", got '" << value << "'" << endl;
+        cerr << "Run with --help for usage." << endl;
+    }
+
+    // Numeric options go through the checked parsers of ParameterFile; a
+    // missing option leaves value unchanged, a malformed one is reported
+    // and returns false.
+    bool readIntOption(const vector<string>& args, const string& option, int& value) {
+        const string text = getOptionValue(args, option, "");
+        if (text.empty() || parseInt(text, value)) {
+            return true;
+        }
+        reportInvalidOption(option, text, "a non-negative integer");
+        return false;
+    }
+
+    bool readDoubleOption(const vector<string>& args, const string& option, double& value) {
+        const string text = getOptionValue(args, option, "");
+        if (text.empty() || parseDouble(text, value)) {
+            return true;
+        }
+        reportInvalidOption(option, text, "a number");
+        return false;
+    }
+
+    bool readDoubleListOption(const vector<string>& args, const string& option, vector<double>& values) {
+        const string text = getOptionValue(args, option, "");
+        stringstream stream(text);
+        string item;
+
+        values.clear();
+        while (getline(stream, item, ',')) {
+            double value = 0.0;
+            if (!parseDouble(item, value)) {
+                reportInvalidOption(option, text, "a comma-separated list of numbers");
+                return false;
+            }
+            values.push_back(value);
+        }
+
+        return true;
+    }
+
+    bool parseMultiColonyOptions(const vector<string>& args, MultiColonyOptions& options) {
+        // --single runs one colony unless --colonies asks for more.
+        options = MultiColonyOptions();
+        options.colonies = 1;
+        return readIntOption(args, "--colonies", options.colonies) &&
+               readIntOption(args, "--migration-interval", options.migrationInterval) &&
+               readDoubleOption(args, "--migration-blend", options.blendWeight) &&
+               readDoubleListOption(args, "--colony-alpha", options.alphas) &&
+               readDoubleListOption(args, "--colony-beta", options.betas) &&
+               readIntOption(args, "--colony-threads", options.threads);
+    }
+
+    // False, after reporting why, when the parameter file cannot be read or
+    // has invalid entries.
+    bool parseAcoParameters(const vector<string>& args, const string& defaultParameterFile, ACOParameters& params) {
+        params = ACOParameters();
+
+        // The parameter file sets the baseline, explicit options override it.
+        string parameterFile = getOptionValue(args, "--params", "");
+        if (parameterFile.empty() && !defaultParameterFile.empty() && fs::exists(defaultParameterFile)) {
+            parameterFile = defaultParameterFile;
+            cout << "Using tuned ACO parameters from " << parameterFile << endl;
+        }
+
+        if (!parameterFile.empty() && !loadParameterFile(parameterFile, params)) {
+            cerr << "Error: invalid parameter file: " << parameterFile << endl;
+            return false;
+        }
+
+        const vector<pair<string, string>> options = {
+            {"--alpha", "alpha"},
+            {"--beta", "beta"},
+            {"--evaporation", "evaporation"},
+            {"--q", "q"},
+            {"--ants", "ants"},
+            {"--iterations", "iterations"},
+            {"--stagnation", "stagnation"},
+            {"--candidates", "candidates"},
+            {"--threads", "threads"},
+            {"--ant-batch", "ant_batch"},
+            {"--strategy", "strategy"},
+            {"--engine", "engine"},
+            {"--sampling", "sampling"},
+            {"--heuristic", "heuristic"},
+            {"--acs-q0", "acs_q0"},
+            {"--acs-local-evaporation", "acs_local_evaporation"},
+            {"--log-level", "log_level"},
+            {"--time-budget", "time_budget"},
+            {"--target-length", "target_length"},
+            {"--seed", "seed"}
+        };
+
+        for (const auto& [option, key] : options) {
+            const string value = getOptionValue(args, option, "");
+            if (!value.empty() && !setParameter(params, key, value)) {
+                reportInvalidOption(option, value, "a valid value");
+                return false;
+            }
+        }
+
+        if (hasFlag(args, "--lazy-evaporation")) {
+            params.lazyEvaporation = true;
+        }
+        if (hasFlag(args, "--prune-dead-ends")) {
+            params.pruneDeadEnds = true;
+        }
+        if (hasFlag(args, "--repair-ants")) {
+            params.repairAnts = true;
+        }
+        if (hasFlag(args, "--branch-and-bound")) {
+            params.branchAndBound = true;
+        }
+
+        return true;
+    }
+
+    // The sparse engine runs the elitist update only, so options it cannot
+    // honour are refused instead of being dropped silently.
+    bool checkSparseOptions(const ACOParameters& params) {
+        const vector<string> unsupported = SparseAntColony::unsupportedOptions(params);
+        if (unsupported.empty()) {
+            return true;
+        }
+
+        cerr << "Error: the sparse engine does not support";
+        for (size_t i = 0; i < unsupported.size(); ++i) {
+            cerr << (i == 0 ? " " : ", ") << unsupported[i];
+        }
+        cerr << endl;
+        cerr << "It runs the elitist strategy only; use --engine dense for these options." << endl;
+        return false;
+    }
+
+    void printRunSummary(const ACOResult& result, const ACOParameters& params) {
+        if (params.logLevel != LogLevel::Off) {
+            AsyncLog::instance().flush();
+        }
+
+        cout << "Seed: " << result.seed << endl;
+        cout << "Stop reason: " << stopReasonName(result.stopReason) << endl;
+        cout << "Ant success rate: " << result.averageSuccessRate() * 100.0 << "%" << endl;
+        cout << "Ants pruned by bound: " << result.prunedAnts() << endl;
+    }
+
+    // Edge lists are read straight into CSR and always run on the sparse
+    // engine, so no n x n matrix is allocated for them.
+    int runEdgeListMode(const string& filename, const ACOParameters& params, const MultiColonyOptions* islands) {
+        if (!checkSparseOptions(params)) {
+            return 1;
+        }
+
         int start = -1;
         int end = -1;
+        CsrGraph graph;
 
-        readGraphFromFile(filename, fileLoaded, graph, labels, start, end);
-
-        if (!fileLoaded) {
+        if (!loadEdgeList(filename, graph, start, end)) {
             cerr << "Error: failed to load graph file: " << filename << endl;
             return 1;
         }
 
-        if (graph.empty() || labels.empty()) {
-            cerr << "Error: graph is empty or malformed." << endl;
+        cout << "Graph loaded with " << graph.vertexCount << " vertices and " << graph.edgeCount << " edges.\n";
+
+        if (islands && islands->colonies > 1) {
+            cerr << "Warning: edge-list files run a single sparse colony." << endl;
+        }
+
+        SparseAntColony colony(move(graph), VertexLabels(), start, end, params);
+        printRunSummary(colony.run(), params);
+        return 0;
+    }
+
+    int runSingleGraphMode(const string& filename, const ACOParameters& params,
+                           const MultiColonyOptions* islands = nullptr) {
+        if (isEdgeListFile(filename)) {
+            return runEdgeListMode(filename, params, islands);
+        }
+
+        int start = -1;
+        int end = -1;
+
+        const GraphPtr graph = loadGraph(filename, start, end);
+
+        if (!graph) {
+            cerr << "Error: failed to load graph file: " << filename << endl;
             return 1;
         }
 
-        if (start < 0 || end < 0 || start >= static_cast<int>(labels.size()) || end >= static_cast<int>(labels.size())) {
+        const int n = graph->size();
+        if (start < 0 || end < 0 || start >= n || end >= n) {
             cerr << "Error: invalid start/end vertices in graph file." << endl;
             return 1;
         }
 
-        cout << "Graph loaded with " << graph.size() << " vertices.\n";
+        cout << "Graph loaded with " << n << " vertices.\n";
         cout << "Vertices: ";
-        for (const auto& l : labels) {
-            cout << l << " ";
+        for (int v = 0; v < n; ++v) {
+            cout << graph->labels()[v] << " ";
         }
         cout << "\n";
 
-        AntColony colony(graph, labels, start, end);
-        colony.run();
+        ACOResult result;
+        if (islands && islands->colonies > 1) {
+            if (params.engine == ACOEngine::Sparse) {
+                cerr << "Warning: the island model runs dense colonies." << endl;
+            }
+
+            MultiColony multi(graph, start, end, params, *islands);
+            const MultiColonyResult islandResult = multi.run();
+            result = islandResult.best;
+
+            if (params.logLevel != LogLevel::Off) {
+                AsyncLog::instance().flush();
+            }
+
+            for (size_t k = 0; k < islandResult.colonies.size(); ++k) {
+                const ACOResult& colony = islandResult.colonies[k];
+                cout << "Colony " << k << ": ";
+                if (colony.pathFound) {
+                    cout << "length " << colony.bestLength << " at iteration " << colony.bestIteration;
+                } else {
+                    cout << "no path";
+                }
+                cout << " (" << colony.iterations << " iterations, seed " << colony.seed << ")" << endl;
+            }
+            cout << "Migrations: " << islandResult.migrations << endl;
+            cout << "Convergence curves saved to: " << islands->convergenceFile << endl;
+        } else if (params.engine == ACOEngine::Sparse) {
+            SparseAntColony colony(CsrGraph::fromAdjacencyMatrix(graph->matrix()), graph->labels(), start, end, params);
+            result = colony.run();
+        } else {
+            AntColony colony(graph, start, end, params);
+            result = colony.run();
+        }
 
+        printRunSummary(result, params);
         return 0;
     }
 
@@ -134,7 +384,7 @@ namespace {
                 cout << "Enter graph filename (txt or csv): ";
                 cin >> filename;
 
-                return runSingleGraphMode(filename);
+                return runSingleGraphMode(filename, ACOParameters());
             } else if (baseCommand == "r") {
                 mainRunFlag = false;
                 pipeline.generateTests();
@@ -168,7 +418,18 @@ int main(int argc, char* argv[]) {
     }
 
     const string testDirectory = getOptionValue(args, "--test-dir", DEFAULT_TEST_DIR);
-    PipelineRunner pipeline(testDirectory);
+    // Only --run aco picks up the result of the last --autotune; every other
+    // mode starts from the built-in defaults unless --params is given, so a
+    // tuning run never shifts the baseline of benchmarks or comparisons.
+    const bool acoRunMode = getOptionValue(args, "--run", "") == "aco";
+    ACOParameters acoParameters;
+    if (!parseAcoParameters(args, acoRunMode ? TUNED_PARAMETERS_FILE : "", acoParameters)) {
+        return 1;
+    }
+    if (acoParameters.engine == ACOEngine::Sparse && !checkSparseOptions(acoParameters)) {
+        return 1;
+    }
+    PipelineRunner pipeline(testDirectory, acoParameters);
 
     if (hasFlag(args, "--generate-tests")) {
         pipeline.generateTests();
@@ -191,6 +452,81 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    if (hasFlag(args, "--compare-strategies")) {
+        if (!pipeline.ensureTestSuiteExists()) {
+            cerr << "Error: test suite not found in " << testDirectory << endl;
+            cerr << "Run --generate-tests first, or use --full-pipeline." << endl;
+            return 1;
+        }
+
+        if (acoParameters.engine == ACOEngine::Sparse) {
+            cerr << "Error: --compare-strategies needs the dense engine; the sparse engine runs elitist only." << endl;
+            return 1;
+        }
+
+        pipeline.compareAcoStrategies();
+        return 0;
+    }
+
+    const string sweepGrid = getOptionValue(args, "--sweep", "");
+    if (!sweepGrid.empty()) {
+        if (!pipeline.ensureTestSuiteExists()) {
+            cerr << "Error: test suite not found in " << testDirectory << endl;
+            cerr << "Run --generate-tests first, or use --full-pipeline." << endl;
+            return 1;
+        }
+
+        vector<ParameterAxis> axes;
+        if (!loadParameterGrid(sweepGrid, axes)) {
+            return 1;
+        }
+
+        int sweepThreads = 0;
+        if (!readIntOption(args, "--sweep-threads", sweepThreads)) {
+            return 1;
+        }
+        pipeline.runParameterSweep(expandParameterGrid(acoParameters, axes), sweepThreads);
+        return 0;
+    }
+
+    if (hasFlag(args, "--autotune")) {
+        if (!pipeline.ensureTestSuiteExists()) {
+            cerr << "Error: test suite not found in " << testDirectory << endl;
+            cerr << "Run --generate-tests first, or use --full-pipeline." << endl;
+            return 1;
+        }
+
+        vector<ACOParameters> candidates = AutoTuner::defaultCandidates(acoParameters);
+
+        const string grid = getOptionValue(args, "--autotune", "");
+        if (!grid.empty() && grid.rfind("--", 0) != 0) {
+            vector<ParameterAxis> axes;
+            if (!loadParameterGrid(grid, axes)) {
+                return 1;
+            }
+            candidates = expandParameterGrid(acoParameters, axes);
+        }
+
+        AutoTuneOptions options;
+        if (!readIntOption(args, "--tune-sample", options.sampleSize) ||
+            !readIntOption(args, "--tune-threads", options.threads)) {
+            return 1;
+        }
+
+        const string output = getOptionValue(args, "--tune-output", TUNED_PARAMETERS_FILE);
+        return pipeline.runAutotune(candidates, options, output) ? 0 : 1;
+    }
+
+    if (hasFlag(args, "--benchmark")) {
+        const string benchmark = getOptionValue(args, "--benchmark", "");
+        if (benchmark.empty() || benchmark.rfind("--", 0) == 0) {
+            printBenchmarkList();
+            return 1;
+        }
+
+        return runBenchmark(benchmark, testDirectory, acoParameters);
+    }
+
     if (hasFlag(args, "--full-pipeline")) {
         pipeline.fullPipeline(true);
         return 0;
@@ -198,7 +534,11 @@ int main(int argc, char* argv[]) {
 
     for (size_t i = 0; i + 1 < args.size(); ++i) {
         if (args[i] == "--single") {
-            return runSingleGraphMode(args[i + 1]);
+            MultiColonyOptions islands;
+            if (!parseMultiColonyOptions(args, islands)) {
+                return 1;
+            }
+            return runSingleGraphMode(args[i + 1], acoParameters, &islands);
         }
 
         if (args[i] == "--run") {